@@ -1,58 +1,69 @@
 #include "configuration.hpp"
+#include <charconv>
 #include <fstream>
-#include <sstream>
 #include <iostream>
-#include <algorithm>
-#include <stdexcept>
-#include <expected>
-
-std::string Configuration::remove_whitespace(const std::string& str) {
-    std::string result;
-    std::copy_if(str.begin(), str.end(), std::back_inserter(result),
-        [](char c) {
-            return !std::isspace(static_cast<unsigned char>(c));
-        });
-    return result;
-}
-
-std::tuple<int, int> Configuration::split_by_comma(const std::string& input) {
-    std::string cleaned = remove_whitespace(input);
-    std::stringstream ss(cleaned);
-    std::string part1, part2;
+#include <iterator>
+#include <sstream>
+#include <string_view>
 
-    if (!std::getline(ss, part1, ',') || !std::getline(ss, part2)) {
-        throw std::invalid_argument("Invalid input format. Expected two comma-separated values.");
+namespace {
+    std::string_view trim(std::string_view sv) {
+        while (!sv.empty() && (sv.front() == ' ' || sv.front() == '\t' || sv.front() == '\r')) {
+            sv.remove_prefix(1);
+        }
+        while (!sv.empty() && (sv.back() == ' ' || sv.back() == '\t' || sv.back() == '\r')) {
+            sv.remove_suffix(1);
+        }
+        return sv;
     }
 
-    int val1 = std::stoi(part1);
-    int val2 = std::stoi(part2);
-
-    return std::make_tuple(val1, val2);
+    template <typename T>
+    bool parseNumber(std::string_view sv, T& out) {
+        sv = trim(sv);
+        auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), out);
+        return ec == std::errc{} && ptr == sv.data() + sv.size();
+    }
 }
 
 std::expected<Configuration, std::string> Configuration::fromFile(const std::filesystem::path& configPath) {
     Configuration config;
-    
-    std::ifstream configFile(configPath);
+
+    // The process restarts on every ignition cycle, so startup allocation
+    // churn is driver-visible latency. The whole file is read into one
+    // buffer up front and every key and value below is a string_view into
+    // it; from_chars replaces the per-value stringstream/stoi round trips.
+    std::ifstream configFile(configPath, std::ios::binary);
     if (!configFile) {
         return std::unexpected("Error opening config file: " + configPath.string());
     }
+    std::string arena((std::istreambuf_iterator<char>(configFile)),
+                      std::istreambuf_iterator<char>());
+
+    std::string_view text(arena);
+    while (!text.empty()) {
+        size_t nl = text.find('\n');
+        std::string_view line = text.substr(0, nl);
+        text.remove_prefix(nl == std::string_view::npos ? text.size() : nl + 1);
 
-    std::string line;
-    while (std::getline(configFile, line)) {
+        line = trim(line);
         if (line.empty() || line[0] == '#')
             continue;
-            
+
         auto delimiterPos = line.find('=');
-        if (delimiterPos == std::string::npos) 
+        if (delimiterPos == std::string_view::npos)
             continue;
-            
-        std::string key = remove_whitespace(line.substr(0, delimiterPos));
-        std::string value = remove_whitespace(line.substr(delimiterPos + 1));
-        
-        try {
-            if (value.find(',') != std::string::npos) {
-                auto [input, output] = split_by_comma(value);
+
+        std::string_view key = trim(line.substr(0, delimiterPos));
+        std::string_view value = trim(line.substr(delimiterPos + 1));
+        bool ok = true;
+
+        auto commaPos = value.find(',');
+        if (commaPos != std::string_view::npos) {
+            // Ratios are written as "input, output" tooth counts.
+            int input = 0, output = 0;
+            ok = parseNumber(value.substr(0, commaPos), input) &&
+                 parseNumber(value.substr(commaPos + 1), output) && input != 0;
+            if (ok) {
                 if (key == "final_drive") {
                     config.gear.final_drive = static_cast<double>(output) / input;
                 }
@@ -60,18 +71,31 @@ std::expected<Configuration, std::string> Configuration::fromFile(const std::fil
                     config.gear.gear_ratios.push_back(static_cast<double>(output) / input);
                 }
             }
-            else if (key == "min_rpm") {
-                config.gear.min_rpm = std::stoi(value);
-            }
-            else if (key == "max_rpm") {
-                config.gear.max_rpm = std::stoi(value);
-            }
-            else if (key == "wheel_circumference") {
-                config.gear.wheel_circumference = std::stod(value);
-            }
         }
-        catch (const std::exception& e) {
-            return std::unexpected("Error parsing config line '" + line + "': " + e.what());
+        else if (key == "min_rpm") {
+            int v = 0;
+            ok = parseNumber(value, v);
+            if (ok) config.gear.min_rpm = v;
+        }
+        else if (key == "max_rpm") {
+            int v = 0;
+            ok = parseNumber(value, v);
+            if (ok) config.gear.max_rpm = v;
+        }
+        else if (key == "wheel_circumference") {
+            double v = 0.0;
+            ok = parseNumber(value, v);
+            if (ok) config.gear.wheel_circumference = v;
+        }
+        else if (key == "smoothing") {
+            config.gear.smoothing = std::string(value);
+        }
+        else if (key == "predictive") {
+            config.gear.predictive = (value == "true" || value == "1");
+        }
+
+        if (!ok) {
+            return std::unexpected("Error parsing config line '" + std::string(line) + "'");
         }
     }
 
@@ -105,7 +129,13 @@ std::expected<Configuration, std::string> Configuration::fromFile(const std::fil
 
 Configuration Configuration::fromCommandLine(int argc, char* argv[]) {
     Configuration config;
-    
+
+    auto intArg = [&](int& i, int fallback) {
+        int v = fallback;
+        parseNumber(std::string_view(argv[++i]), v);
+        return v;
+    };
+
     for (int i = 1; i < argc; ++i) {
         std::string_view arg = argv[i];
         if (arg == "--test" || arg == "-t") {
@@ -114,31 +144,75 @@ Configuration Configuration::fromCommandLine(int argc, char* argv[]) {
         else if (arg == "--debug" || arg == "-d") {
             config.app.debug_mode = true;
         }
+        else if (arg == "--binary-log" || arg == "-b") {
+            config.app.binary_log = true;
+        }
+        else if (arg == "--async-writer" || arg == "-a") {
+            config.app.async_writer = true;
+        }
+        else if (arg == "--monitor" || arg == "-m") {
+            config.app.monitor_mode = true;
+        }
+        else if (arg == "--shm-export" || arg == "-s") {
+            config.app.shm_export = true;
+        }
         else if (arg == "--config" && i + 1 < argc) {
             config.app.config_path = argv[++i];
         }
         else if (arg == "--output" && i + 1 < argc) {
             config.app.output_path = argv[++i];
         }
+        else if (arg == "--replay" && i + 1 < argc) {
+            config.app.replay_path = argv[++i];
+        }
         else if (arg == "--port" && i + 1 < argc) {
             config.app.serial_port = argv[++i];
         }
+        else if (arg == "--aux-port" && i + 1 < argc) {
+            config.app.aux_port = argv[++i];
+        }
+        else if (arg == "--aux-pids" && i + 1 < argc) {
+            config.app.aux_pids = argv[++i];
+        }
         else if (arg == "--baud" && i + 1 < argc) {
-            config.app.baud_rate = std::stoi(argv[++i]);
+            config.app.baud_rate = intArg(i, config.app.baud_rate);
+        }
+        else if (arg == "--sync-interval" && i + 1 < argc) {
+            config.app.sync_interval_ms = intArg(i, config.app.sync_interval_ms);
+        }
+        else if (arg == "--deadband" && i + 1 < argc) {
+            config.app.deadband_rpm = intArg(i, config.app.deadband_rpm);
+        }
+        else if (arg == "--latency-mode" || arg == "-l") {
+            config.app.latency_mode = true;
+        }
+        else if (arg == "--pin-core" && i + 1 < argc) {
+            config.app.pin_core = intArg(i, config.app.pin_core);
         }
         else if (arg == "--help" || arg == "-h") {
             std::cout << "Usage: " << argv[0] << " [options]\n";
             std::cout << "Options:\n";
             std::cout << "  --test, -t          Use dummy ELM327 for testing\n";
             std::cout << "  --debug, -d         Enable debug output\n";
+            std::cout << "  --binary-log, -b    Log sessions in the binary .rrl format\n";
+            std::cout << "  --async-writer, -a  Format and flush rows on a dedicated writer thread\n";
+            std::cout << "  --monitor, -m       Passive ATMA capture instead of polled PIDs\n";
+            std::cout << "  --shm-export, -s    Publish live telemetry to a shared-memory ring\n";
             std::cout << "  --config <file>     Specify config file path\n";
             std::cout << "  --output <file>     Specify output CSV file path\n";
+            std::cout << "  --replay <file>     Session log to replay in test mode\n";
             std::cout << "  --port <port>       Serial port (default: COM9)\n";
+            std::cout << "  --aux-port <port>   Second adapter for extra PID channels\n";
+            std::cout << "  --aux-pids \"<A> <B>\" The two PIDs the second adapter polls (default \"5C 5E\")\n";
             std::cout << "  --baud <rate>       Baud rate (default: 38400)\n";
+            std::cout << "  --sync-interval <ms> fsync the log to disk every <ms> (0 = off)\n";
+            std::cout << "  --deadband <rpm>    Suppress rows within <rpm> of the last written row\n";
+            std::cout << "  --latency-mode, -l  Run the cue path and logging path on separate lanes\n";
+            std::cout << "  --pin-core <n>      Pin the hot cue lane to core <n> (with --latency-mode)\n";
             std::cout << "  --help, -h          Show this help message\n";
             std::exit(0);
         }
     }
-    
+
     return config;
-}
\ No newline at end of file
+}
@@ -19,16 +19,29 @@ public:
         std::optional<double> wheel_circumference;
         std::optional<int> min_rpm;
         std::optional<int> max_rpm;
+        std::optional<std::string> smoothing; // none / moving_average / exponential
+        bool predictive = false; // extrapolate one sample interval ahead in revMatcher
     };
 
     struct AppConfig {
         std::filesystem::path config_path = "C:/Users/Will/Documents/rpmrevmatch/config.txt";
         std::filesystem::path output_path = make_output_path();
         std::filesystem::path raw_output_path = make_output_path();
+        std::filesystem::path replay_path = "logs/2025-08-18_16-13-04.csv";
         std::string serial_port = "COM9";
+        std::string aux_port = ""; // second adapter for extra PID channels; empty = single adapter
+        std::string aux_pids = "5C 5E"; // the two PIDs the second adapter polls (default oil temp, fuel rate)
         int baud_rate = 38400;
         bool test_mode = false;
         bool debug_mode = false;
+        bool binary_log = false;
+        bool async_writer = false;
+        bool monitor_mode = false;
+        bool shm_export = false;
+        int sync_interval_ms = 0; // 0 disables the periodic fsync of the log file
+        int deadband_rpm = 0; // 0 disables idle-row write suppression
+        bool latency_mode = false; // cue path and logging path on separate lanes
+        int pin_core = -1; // pin the hot cue lane to this core (-1 = unpinned)
     };
 
     GearConfig gear;
@@ -37,8 +50,6 @@ public:
     static Configuration fromCommandLine(int argc, char* argv[]);
 
 private:
-    static std::string remove_whitespace(const std::string& str);
-    static std::tuple<int, int> split_by_comma(const std::string& input);
     static inline std::filesystem::path make_output_path() {
         auto now = std::chrono::system_clock::now();
         std::time_t t = std::chrono::system_clock::to_time_t(now);
@@ -48,12 +59,9 @@ private:
     #else
             localtime_r(&t, &local_tm);
     #endif
-            std::ostringstream oss;
-            oss << "logs/"
-                << std::put_time(&local_tm, "%Y-%m-%d_%H-%M-%S")
-                << ".csv";
-
-            return oss.str();
+            char buf[64];
+            std::strftime(buf, sizeof(buf), "logs/%Y-%m-%d_%H-%M-%S.csv", &local_tm);
+            return buf;
     }
 
 
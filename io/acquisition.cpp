@@ -0,0 +1,134 @@
+#include "acquisition.hpp"
+
+MultiAdapterAcquisition::MultiAdapterAcquisition(const SignalHandler& handler)
+    : handler(handler)
+{
+}
+
+void MultiAdapterAcquisition::addSource(std::unique_ptr<ELM327Base> adapter, std::string command)
+{
+    auto source = std::make_unique<Source>();
+    source->adapter = std::move(adapter);
+    source->command = std::move(command);
+    sources.push_back(std::move(source));
+}
+
+void MultiAdapterAcquisition::start()
+{
+    if (started)
+    {
+        return;
+    }
+    started = true;
+    for (auto& source : sources)
+    {
+        source->thread = std::thread([this, &src = *source]() { pollLoop(src); });
+    }
+}
+
+void MultiAdapterAcquisition::pollLoop(Source& source)
+{
+    int sourceIndex = 0;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        if (sources[i].get() == &source)
+        {
+            sourceIndex = static_cast<int>(i);
+        }
+    }
+
+    while (!stopRequested.load() && handler.isRunning())
+    {
+        auto result = source.adapter->getEngineData(handler, source.command);
+        if (!result)
+        {
+            // Covers link-down periods too; the interface reconnects in
+            // the background while we back off here.
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        auto [rpm, mph, load, throttle, timestamp] = *result;
+        AcquiredSample sample{sourceIndex, rpm, mph, load, throttle, timestamp};
+        while (!source.ring.push(sample) && !stopRequested.load() && handler.isRunning())
+        {
+            // Consumer behind; the serial link is the slow side in every
+            // healthy configuration, so this backoff is rare.
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        sampleReady.notify_one();
+    }
+}
+
+std::optional<AcquiredSample> MultiAdapterAcquisition::next()
+{
+    auto deadline = std::chrono::steady_clock::now() + REORDER_WINDOW;
+    while (true)
+    {
+        // Top up the staged head of every source, then release the oldest
+        // once every source has one (true merge order) or the reorder
+        // window has elapsed (bounded wait on a lagging source).
+        bool allStaged = true;
+        for (auto& source : sources)
+        {
+            if (!source->staged)
+            {
+                AcquiredSample sample;
+                if (source->ring.pop(sample))
+                {
+                    source->staged = sample;
+                }
+                else
+                {
+                    allStaged = false;
+                }
+            }
+        }
+
+        Source* oldest = nullptr;
+        for (auto& source : sources)
+        {
+            if (source->staged &&
+                (!oldest || source->staged->timestamp < oldest->staged->timestamp))
+            {
+                oldest = source.get();
+            }
+        }
+
+        if (oldest && (allStaged || std::chrono::steady_clock::now() >= deadline))
+        {
+            AcquiredSample sample = *oldest->staged;
+            oldest->staged.reset();
+            return sample;
+        }
+        if (!handler.isRunning())
+        {
+            if (oldest)
+            {
+                AcquiredSample sample = *oldest->staged;
+                oldest->staged.reset();
+                return sample;
+            }
+            return std::nullopt;
+        }
+        // Nothing new staged: block until a poll thread pushes. The timeout
+        // only bounds a notify lost between the pops above and this wait,
+        // so the common case is an immediate wakeup with no fixed sleep in
+        // the sample path.
+        std::unique_lock<std::mutex> lock(mergeMutex);
+        sampleReady.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+MultiAdapterAcquisition::~MultiAdapterAcquisition()
+{
+    stopRequested.store(true);
+    sampleReady.notify_all();
+    for (auto& source : sources)
+    {
+        if (source->thread.joinable())
+        {
+            source->thread.join();
+        }
+    }
+}
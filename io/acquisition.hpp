@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../utils/signal_handler.hpp"
+#include "../utils/spsc_ring.hpp"
+#include "elm327.hpp"
+
+// Multi-adapter acquisition. Each 38400-baud link is already saturated, so
+// extra PID channels have to come from extra adapters on their own ports.
+// Every source gets a polling thread that drains its ELM327Base into a
+// lock-free ring; the consumer merges the streams by timestamp with a
+// bounded reordering window, so a briefly lagging source delays the merge
+// by at most the window rather than stalling it.
+
+struct AcquiredSample
+{
+    int source; // index in addSource order; 0 drives the GearBox
+    int rpm;
+    int mph;
+    int load;
+    int throttle;
+    long long timestamp;
+};
+
+class MultiAdapterAcquisition
+{
+private:
+    struct Source
+    {
+        std::unique_ptr<ELM327Base> adapter;
+        std::string command;
+        SpscRing<AcquiredSample, 256> ring;
+        std::thread thread;
+        // Head-of-stream sample awaiting merge.
+        std::optional<AcquiredSample> staged;
+    };
+
+    std::vector<std::unique_ptr<Source>> sources;
+    const SignalHandler& handler;
+    std::atomic<bool> stopRequested{false};
+    bool started = false;
+
+    // Poll threads signal after every push so next() wakes immediately
+    // instead of sleep-polling; the rings themselves stay lock-free.
+    std::mutex mergeMutex;
+    std::condition_variable sampleReady;
+
+    // How long the merge waits for a lagging source before releasing the
+    // oldest staged sample anyway.
+    static constexpr std::chrono::milliseconds REORDER_WINDOW{50};
+
+    void pollLoop(Source& source);
+
+public:
+    explicit MultiAdapterAcquisition(const SignalHandler& handler);
+
+    void addSource(std::unique_ptr<ELM327Base> adapter, std::string command);
+    size_t sourceCount() const { return sources.size(); }
+
+    void start();
+
+    // Next sample in timestamp order across all sources, or nullopt when
+    // polling has stopped and everything staged has drained.
+    std::optional<AcquiredSample> next();
+
+    ~MultiAdapterAcquisition();
+};
@@ -0,0 +1,226 @@
+#include "binary_log.hpp"
+#include <cstring>
+#include <format>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+BinaryLogWriter::BinaryLogWriter(const std::filesystem::path &filename,
+                                 bool debug,
+                                 size_t maxRecords,
+                                 std::chrono::milliseconds interval,
+                                 std::chrono::milliseconds syncInterval,
+                                 int deadbandRpm)
+    : maxBufferRecords(maxRecords),
+      flushInterval(interval),
+      debugMode(debug),
+      sessionIndex(filename),
+      deadband(deadbandRpm)
+{
+    if (syncInterval.count() > 0)
+    {
+        if (!durable.open(filename, syncInterval))
+        {
+            std::cerr << "FATAL ERROR: Could not open or create file: " << filename.generic_string() << std::endl;
+            throw std::runtime_error("Failed to open file: " + filename.generic_string());
+        }
+    }
+    else
+    {
+        file.open(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "FATAL ERROR: Could not open or create file: " << filename.generic_string() << std::endl;
+            throw std::runtime_error("Failed to open file: " + filename.generic_string());
+        }
+    }
+
+    std::cout << "Successfully opened " << filename.generic_string() << " for binary logging." << std::endl;
+
+    BinaryLogHeader header{};
+    std::memcpy(header.magic, BINARY_LOG_MAGIC, sizeof(header.magic));
+    header.version = BINARY_LOG_VERSION;
+    header.recordSize = sizeof(BinaryLogRecord);
+    if (durable.isOpen())
+    {
+        durable.write(&header, sizeof(header));
+    }
+    else
+    {
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    buffer.reserve(maxBufferRecords);
+    lastFlush = std::chrono::steady_clock::now();
+}
+
+void BinaryLogWriter::writeRow(int rpm, double speed, int gear, int revMatch,
+                               int load, int throttle, int64_t timestamp)
+{
+    if (debugMode)
+    {
+        std::cout << std::format("RPM: {}, MPH: {:.1f}, Current Gear: {}, Target RPM: {}, Time: {}\n",
+                                 rpm, speed, gear, revMatch, timestamp);
+    }
+
+    if (!deadband.shouldWrite(rpm, speed, gear, revMatch))
+    {
+        return;
+    }
+
+    buffer.push_back(BinaryLogRecord{timestamp, rpm, static_cast<float>(speed),
+                                     gear, revMatch, load, throttle});
+    sessionIndex.addRow(rpm, speed, gear, revMatch, load, throttle, timestamp);
+
+    auto now = std::chrono::steady_clock::now();
+
+    if (buffer.size() >= maxBufferRecords || (now - lastFlush) >= flushInterval)
+    {
+        flush();
+    }
+}
+
+void BinaryLogWriter::flush()
+{
+    if (!buffer.empty())
+    {
+        if (durable.isOpen())
+        {
+            durable.write(buffer.data(), buffer.size() * sizeof(BinaryLogRecord));
+        }
+        else
+        {
+            file.write(reinterpret_cast<const char *>(buffer.data()),
+                       static_cast<std::streamsize>(buffer.size() * sizeof(BinaryLogRecord)));
+            file.flush();
+        }
+        buffer.clear();
+        lastFlush = std::chrono::steady_clock::now();
+        writeCount++;
+    }
+}
+
+BinaryLogWriter::~BinaryLogWriter()
+{
+    if (!buffer.empty())
+    {
+        std::cout << "Flushing remaining binary log data on exit. Total writes: " << writeCount << "..." << std::endl;
+        flush();
+    }
+    if (deadband.suppressedRows > 0)
+    {
+        std::cout << "Deadband suppressed " << deadband.suppressedRows << " records this session.\n";
+    }
+}
+
+BinaryLogReader::BinaryLogReader(const std::filesystem::path &filename)
+{
+#ifdef _WIN32
+    HANDLE fileH = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileH == INVALID_HANDLE_VALUE)
+    {
+        std::cerr << "Warning: Could not open binary log: " << filename.generic_string() << '\n';
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileH, &size) || static_cast<size_t>(size.QuadPart) < sizeof(BinaryLogHeader))
+    {
+        CloseHandle(fileH);
+        return;
+    }
+
+    HANDLE mapH = CreateFileMappingW(fileH, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapH)
+    {
+        CloseHandle(fileH);
+        return;
+    }
+
+    const char *base = static_cast<const char *>(MapViewOfFile(mapH, FILE_MAP_READ, 0, 0, 0));
+    if (!base)
+    {
+        CloseHandle(mapH);
+        CloseHandle(fileH);
+        return;
+    }
+
+    fileHandle = fileH;
+    mappingHandle = mapH;
+    mapping = base;
+    mappedSize = static_cast<size_t>(size.QuadPart);
+#else
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Warning: Could not open binary log: " << filename.generic_string() << '\n';
+        return;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BinaryLogHeader))
+    {
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+
+    void *base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED)
+    {
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+
+    mapping = static_cast<const char *>(base);
+    mappedSize = static_cast<size_t>(st.st_size);
+#endif
+
+    BinaryLogHeader header{};
+    std::memcpy(&header, mapping, sizeof(header));
+    if (std::memcmp(header.magic, BINARY_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != BINARY_LOG_VERSION ||
+        header.recordSize != sizeof(BinaryLogRecord))
+    {
+        std::cerr << "Warning: " << filename.generic_string() << " is not a valid binary log\n";
+        return;
+    }
+
+    records = reinterpret_cast<const BinaryLogRecord *>(mapping + sizeof(BinaryLogHeader));
+    count = (mappedSize - sizeof(BinaryLogHeader)) / sizeof(BinaryLogRecord);
+}
+
+BinaryLogReader::~BinaryLogReader()
+{
+#ifdef _WIN32
+    if (mapping)
+    {
+        UnmapViewOfFile(mapping);
+    }
+    if (mappingHandle)
+    {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle)
+    {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (mapping)
+    {
+        munmap(const_cast<char *>(mapping), mappedSize);
+    }
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+#endif
+}
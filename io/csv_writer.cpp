@@ -1,6 +1,55 @@
 #include "csv_writer.hpp"
+#include <cmath>
 #include <format>
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+bool DurableFile::open(const std::filesystem::path& filename, std::chrono::milliseconds interval)
+{
+    rawFile = std::fopen(filename.string().c_str(), "wb");
+    if (!rawFile)
+    {
+        return false;
+    }
+    syncInterval = interval;
+    lastSync = std::chrono::steady_clock::now();
+    return true;
+}
+
+void DurableFile::write(const void* data, size_t size)
+{
+    std::fwrite(data, 1, size, rawFile);
+    std::fflush(rawFile);
+    auto now = std::chrono::steady_clock::now();
+    if ((now - lastSync) >= syncInterval)
+    {
+        syncToDisk();
+        lastSync = now;
+    }
+}
+
+void DurableFile::syncToDisk()
+{
+#ifdef _WIN32
+    _commit(_fileno(rawFile));
+#else
+    fsync(fileno(rawFile));
+#endif
+}
+
+DurableFile::~DurableFile()
+{
+    if (rawFile)
+    {
+        syncToDisk();
+        std::fclose(rawFile);
+    }
+}
+
 DummyCSVWriter::DummyCSVWriter() = default;
 
 void DummyCSVWriter::writeRow(int rpm, double speed, int gear, int revMatch,
@@ -18,26 +67,48 @@ void DummyCSVWriter::flush()
 BufferedCSVWriter::BufferedCSVWriter(const std::filesystem::path& filename,
                                      bool debug,
                                      size_t maxBuffer,
-                                     std::chrono::milliseconds interval)
-    : file(filename),
-      maxBufferSize(maxBuffer),
+                                     std::chrono::milliseconds interval,
+                                     std::chrono::milliseconds syncInterval,
+                                     int deadbandRpm,
+                                     bool auxColumns)
+    : maxBufferSize(maxBuffer),
       flushInterval(interval),
-      debugMode(debug)
+      debugMode(debug),
+      sessionIndex(filename),
+      deadband(deadbandRpm),
+      auxColumns(auxColumns)
 {
-    if (!file.is_open())
+    if (syncInterval.count() > 0)
     {
-        std::cerr << "FATAL ERROR: Could not open or create file: " << filename.generic_string() << std::endl;
-        if (file.fail())
+        if (!durable.open(filename, syncInterval))
         {
-            std::cerr << "Reason: I/O error on open." << std::endl;
+            std::cerr << "FATAL ERROR: Could not open or create file: " << filename.generic_string() << std::endl;
+            throw std::runtime_error("Failed to open file: " + filename.generic_string());
+        }
+    }
+    else
+    {
+        file.open(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "FATAL ERROR: Could not open or create file: " << filename.generic_string() << std::endl;
+            if (file.fail())
+            {
+                std::cerr << "Reason: I/O error on open." << std::endl;
+            }
+            throw std::runtime_error("Failed to open file: " + filename.generic_string());
         }
-        throw std::runtime_error("Failed to open file: " + filename.generic_string());
     }
 
     std::cout << "Successfully opened " << filename.generic_string() << " for writing." << std::endl;
 
     lastFlush = std::chrono::steady_clock::now();
-    buffer << "RPM,MPH,CurrentGear,RevMatch,Load,Throttle,Time\n";
+    buffer << "RPM,MPH,CurrentGear,RevMatch,Load,Throttle,Time";
+    if (auxColumns)
+    {
+        buffer << ",Aux1,Aux2";
+    }
+    buffer << '\n';
 }
 
 void BufferedCSVWriter::writeRow(int rpm, double speed, int gear, int revMatch,
@@ -49,9 +120,21 @@ void BufferedCSVWriter::writeRow(int rpm, double speed, int gear, int revMatch,
                                  rpm, speed, gear, revMatch, timestamp);
     }
 
+    if (!deadband.shouldWrite(rpm, speed, gear, revMatch))
+    {
+        return;
+    }
+
     buffer << rpm << "," << std::fixed << std::setprecision(1) << speed
            << "," << gear << "," << revMatch << "," << load
-           << "," << throttle << "," << timestamp << '\n';
+           << "," << throttle << "," << timestamp;
+    if (auxColumns)
+    {
+        buffer << "," << aux1 << "," << aux2;
+    }
+    buffer << '\n';
+
+    sessionIndex.addRow(rpm, speed, gear, revMatch, load, throttle, timestamp);
 
     auto now = std::chrono::steady_clock::now();
 
@@ -64,15 +147,37 @@ void BufferedCSVWriter::writeRow(int rpm, double speed, int gear, int revMatch,
 
 void BufferedCSVWriter::flush()
 {
-    if (!buffer.str().empty())
+    if (buffer.tellp() <= 0)
+    {
+        return;
+    }
+
+    // Swap the buffered text out before touching the file, so new rows keep
+    // formatting into an empty buffer even if the write or sync below is
+    // slow. With AsyncCSVWriter in front, a stalled fsync therefore costs
+    // the writer thread time but never stalls writeRow on the sampling side.
+    std::string pending = buffer.str();
+    buffer.str("");
+    buffer.clear();
+
+    if (durable.isOpen())
     {
-        file << buffer.str();
+        durable.write(pending.data(), pending.size());
+    }
+    else
+    {
+        file << pending;
         file.flush();
-        buffer.str("");
-        buffer.clear();
-        lastFlush = std::chrono::steady_clock::now();
-        writeCount++;
     }
+
+    lastFlush = std::chrono::steady_clock::now();
+    writeCount++;
+}
+
+void BufferedCSVWriter::updateAux(int newAux1, int newAux2)
+{
+    aux1 = newAux1;
+    aux2 = newAux2;
 }
 
 BufferedCSVWriter::~BufferedCSVWriter()
@@ -82,4 +187,83 @@ BufferedCSVWriter::~BufferedCSVWriter()
         std::cout << "Flushing remaining CSV data on exit. Total writes: " << writeCount << "..." << std::endl;
         flush();
     }
+    if (deadband.suppressedRows > 0)
+    {
+        std::cout << "Deadband suppressed " << deadband.suppressedRows << " rows this session.\n";
+    }
+}
+
+AsyncCSVWriter::AsyncCSVWriter(std::unique_ptr<BufferedCSVWriterBase> sink)
+    : sink(std::move(sink))
+{
+    writerThread = std::thread([this]() { writerLoop(); });
+}
+
+void AsyncCSVWriter::writeRow(int rpm, double speed, int gear, int revMatch,
+                              int load, int throttle, int64_t timestamp)
+{
+    if (!ring.push(Record{rpm, speed, gear, revMatch, load, throttle, timestamp}))
+    {
+        // Ring full means the writer thread is badly behind; dropping beats
+        // blocking the sampling loop.
+        droppedRows++;
+    }
+}
+
+void AsyncCSVWriter::updateAux(int aux1, int aux2)
+{
+    // Applied directly rather than through the ring: a queued row picking
+    // up an aux value a few milliseconds newer is well inside the second
+    // adapter's own sampling cadence.
+    sink->updateAux(aux1, aux2);
+}
+
+void AsyncCSVWriter::flush()
+{
+    flushRequested.store(true);
+}
+
+void AsyncCSVWriter::writerLoop()
+{
+    Record rec;
+    while (!stopRequested.load())
+    {
+        bool didWork = false;
+        while (ring.pop(rec))
+        {
+            sink->writeRow(rec.rpm, rec.speed, rec.gear, rec.revMatch,
+                           rec.load, rec.throttle, rec.timestamp);
+            didWork = true;
+        }
+        if (flushRequested.exchange(false))
+        {
+            sink->flush();
+            didWork = true;
+        }
+        if (!didWork)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // Drain whatever the sampling loop managed to push before shutdown.
+    while (ring.pop(rec))
+    {
+        sink->writeRow(rec.rpm, rec.speed, rec.gear, rec.revMatch,
+                       rec.load, rec.throttle, rec.timestamp);
+    }
+    sink->flush();
+}
+
+AsyncCSVWriter::~AsyncCSVWriter()
+{
+    stopRequested.store(true);
+    if (writerThread.joinable())
+    {
+        writerThread.join();
+    }
+    if (droppedRows > 0)
+    {
+        std::cerr << "AsyncCSVWriter dropped " << droppedRows << " rows (writer thread fell behind)\n";
+    }
 }
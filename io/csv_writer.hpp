@@ -9,6 +9,14 @@
 #include <format>
 #include <cstdint>
 #include <iomanip>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cmath>
+#include "../utils/spsc_ring.hpp"
+#include "../utils/telemetry_ring.hpp"
+#include "session_index.hpp"
 
 class BufferedCSVWriterBase
 {
@@ -18,6 +26,21 @@ public:
     virtual void writeRow(int rpm, double speed, int gear, int revMatch,
                           int load, int throttle, int64_t timestamp) = 0;
 
+    // Consume annotated samples straight out of the shared telemetry ring by
+    // sequence range; the default just forwards each index to writeRow.
+    virtual void writeRange(const TelemetryRing& ring, size_t first, size_t count)
+    {
+        for (size_t seq = first; seq < first + count; ++seq)
+        {
+            writeRow(ring.rpmAt(seq), ring.mphAt(seq), ring.gearAt(seq), ring.revMatchAt(seq),
+                     ring.loadAt(seq), ring.throttleAt(seq), ring.timestampAt(seq));
+        }
+    }
+
+    // Latest values from secondary acquisition channels (a second adapter
+    // on its own port). Writers without extra columns ignore them.
+    virtual void updateAux(int /*aux1*/, int /*aux2*/) {}
+
     virtual void flush() = 0;
 };
 
@@ -34,6 +57,88 @@ public:
     void flush() override;
 };
 
+// Stdio-backed durable output for the writers' --sync-interval mode: writes
+// go through a FILE* so the OS handle is available for a real fsync/_commit
+// on the configured cadence — std::ofstream's flush only drains the library
+// buffer and loses the tail of a session on hard power-off. Shared by the
+// CSV and binary writers so the sync cadence cannot drift between formats.
+class DurableFile
+{
+private:
+    FILE* rawFile = nullptr;
+    std::chrono::milliseconds syncInterval{0};
+    std::chrono::steady_clock::time_point lastSync;
+
+public:
+    DurableFile() = default;
+    DurableFile(const DurableFile&) = delete;
+    DurableFile& operator=(const DurableFile&) = delete;
+
+    bool open(const std::filesystem::path& filename, std::chrono::milliseconds interval);
+    bool isOpen() const { return rawFile != nullptr; }
+
+    // fwrite + fflush, plus a device sync once per sync interval.
+    void write(const void* data, size_t size);
+
+    // fflush only moves data into the OS page cache; this pushes it to the
+    // device so a power cut loses at most one sync interval of rows.
+    void syncToDisk();
+
+    ~DurableFile();
+};
+
+// Deadband suppression shared by the CSV and binary writers: idle dominates
+// real sessions, so rows whose RPM is within the band (and speed within
+// 1 mph) of the last written row are dropped. Gear changes and rev-match
+// activation always write, and a keepalive row goes out at least once a
+// second so the timeline stays continuous for replay tools.
+class DeadbandFilter
+{
+private:
+    int deadbandRpm;
+    int lastRpm = -1;
+    double lastSpeed = -1.0;
+    int lastGear = -1;
+    int lastRevMatch = -1;
+    std::chrono::steady_clock::time_point lastWrite;
+    static constexpr std::chrono::milliseconds KEEPALIVE_INTERVAL{1000};
+
+public:
+    int suppressedRows = 0;
+
+    explicit DeadbandFilter(int deadbandRpm)
+        : deadbandRpm(deadbandRpm), lastWrite(std::chrono::steady_clock::now())
+    {
+    }
+
+    // True when the row should be written; a written row becomes the new
+    // baseline. The first row always writes: lastGear starts at -1, which
+    // reads as a gear change.
+    bool shouldWrite(int rpm, double speed, int gear, int revMatch)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (deadbandRpm > 0)
+        {
+            bool gearEvent = gear != lastGear ||
+                             (revMatch > 0 && lastRevMatch <= 0);
+            bool withinBand = std::abs(rpm - lastRpm) <= deadbandRpm &&
+                              std::abs(speed - lastSpeed) <= 1.0;
+            bool keepaliveDue = (now - lastWrite) >= KEEPALIVE_INTERVAL;
+            if (!gearEvent && withinBand && !keepaliveDue)
+            {
+                suppressedRows++;
+                return false;
+            }
+        }
+        lastRpm = rpm;
+        lastSpeed = speed;
+        lastGear = gear;
+        lastRevMatch = revMatch;
+        lastWrite = now;
+        return true;
+    }
+};
+
 class BufferedCSVWriter : public BufferedCSVWriterBase
 {
 private:
@@ -45,18 +150,83 @@ private:
     std::chrono::milliseconds flushInterval;
     bool debugMode;
 
+    // Durability mode, active when a sync interval is configured. Pair with
+    // AsyncCSVWriter so syncs happen on the writer thread, never the
+    // sampling thread.
+    DurableFile durable;
+
+    // Chunk statistics for the session index; appended when the session
+    // closes (destruction runs finalize).
+    SessionIndexBuilder sessionIndex;
+
+    DeadbandFilter deadband;
+
+    // Optional extra columns fed by a second adapter; each row carries the
+    // most recent values merged in by the acquisition engine.
+    bool auxColumns;
+    int aux1 = -1;
+    int aux2 = -1;
+
 public:
     int writeCount = 0;
 
     BufferedCSVWriter(const std::filesystem::path& filename,
                       bool debug = false,
                       size_t maxBuffer = 8192,
-                      std::chrono::milliseconds interval = std::chrono::seconds(5));
+                      std::chrono::milliseconds interval = std::chrono::seconds(5),
+                      std::chrono::milliseconds syncInterval = std::chrono::milliseconds(0),
+                      int deadbandRpm = 0,
+                      bool auxColumns = false);
 
     void writeRow(int rpm, double speed, int gear, int revMatch,
                   int load, int throttle, int64_t timestamp) override;
 
+    void updateAux(int aux1, int aux2) override;
+
     void flush() override;
 
     ~BufferedCSVWriter() override;
 };
+
+// Async decorator for any writer sink. The sampling loop pushes fixed-size
+// records into a lock-free ring; all formatting, buffering and flushing
+// happens on a dedicated writer thread, so a slow filesystem can no longer
+// stall the polling loop and skew the timestamp deltas GearBox depends on.
+class AsyncCSVWriter : public BufferedCSVWriterBase
+{
+private:
+    struct Record
+    {
+        int rpm;
+        double speed;
+        int gear;
+        int revMatch;
+        int load;
+        int throttle;
+        int64_t timestamp;
+    };
+
+    static constexpr size_t RING_CAPACITY = 4096;
+
+    std::unique_ptr<BufferedCSVWriterBase> sink;
+    SpscRing<Record, RING_CAPACITY> ring;
+    std::thread writerThread;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> flushRequested{false};
+
+    void writerLoop();
+
+public:
+    int droppedRows = 0;
+
+    explicit AsyncCSVWriter(std::unique_ptr<BufferedCSVWriterBase> sink);
+
+    void writeRow(int rpm, double speed, int gear, int revMatch,
+                  int load, int throttle, int64_t timestamp) override;
+
+    void updateAux(int aux1, int aux2) override;
+
+    void flush() override;
+
+    ~AsyncCSVWriter() override;
+};
@@ -1,18 +1,20 @@
 #include <algorithm>
 #include <chrono>
 #include "elm327.hpp"
+#include "../utils/instrumentation.hpp"
 
 ELM327Interface::ELM327Interface(const std::string &portName, unsigned int baudRate)
-    : serial(io)
+    : serial(io), pollTimer(io), portName(portName), baudRate(baudRate)
 {
+    freeSlots.reserve(RESPONSE_POOL_SIZE);
+    for (size_t slot = 0; slot < RESPONSE_POOL_SIZE; ++slot)
+    {
+        freeSlots.push_back(slot);
+    }
+
     try
     {
-        serial.open(portName);
-        serial.set_option(boost::asio::serial_port_base::baud_rate(baudRate));
-        serial.set_option(boost::asio::serial_port_base::character_size(8));
-        serial.set_option(boost::asio::serial_port_base::parity(boost::asio::serial_port_base::parity::none));
-        serial.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one));
-        serial.set_option(boost::asio::serial_port_base::flow_control(boost::asio::serial_port_base::flow_control::none));
+        configurePort();
     }
     catch (const boost::system::system_error &e)
     {
@@ -20,22 +22,478 @@ ELM327Interface::ELM327Interface(const std::string &portName, unsigned int baudR
         throw;
     }
 
+    if (!tryWarmStart())
+    {
+        runFullInit();
+    }
+
+    // Default cadences: RPM and speed on every cycle, the slow-moving PIDs
+    // once a second.
+    setPidSchedule("0C", std::chrono::milliseconds(0));
+    setPidSchedule("0D", std::chrono::milliseconds(0));
+    setPidSchedule("04", std::chrono::milliseconds(1000));
+    setPidSchedule("11", std::chrono::milliseconds(1000));
+    setPidSchedule("05", std::chrono::milliseconds(1000));
+}
+
+void ELM327Interface::configurePort()
+{
+    serial.open(portName);
+    serial.set_option(boost::asio::serial_port_base::baud_rate(baudRate));
+    serial.set_option(boost::asio::serial_port_base::character_size(8));
+    serial.set_option(boost::asio::serial_port_base::parity(boost::asio::serial_port_base::parity::none));
+    serial.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one));
+    serial.set_option(boost::asio::serial_port_base::flow_control(boost::asio::serial_port_base::flow_control::none));
+}
+
+void ELM327Interface::beginReconnect()
+{
+    linkUp.store(false);
+    pipelineRunning.store(false);
+    responseReady.notify_all();
+    if (shuttingDown.load() || reconnecting.exchange(true))
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(reconnectThreadMutex);
+    if (shuttingDown.load())
+    {
+        // The destructor won the race for the mutex; do not spawn a thread
+        // it can no longer see.
+        reconnecting.store(false);
+        return;
+    }
+    // A previous attempt has finished (reconnecting was false), so this
+    // join is instant.
+    if (reconnectThread.joinable())
+    {
+        reconnectThread.join();
+    }
+    std::cerr << "ELM327 link lost; reconnecting in the background\n";
+    reconnectThread = std::thread([this]() { reconnectLoop(); });
+}
+
+void ELM327Interface::reconnectLoop()
+{
+    {
+        std::lock_guard<std::mutex> lock(pipelineMutex);
+        stopPipeline();
+    }
+    while (!shuttingDown.load())
+    {
+        std::this_thread::sleep_for(RECONNECT_BACKOFF);
+        try
+        {
+            std::lock_guard<std::mutex> lock(pipelineMutex);
+            boost::system::error_code ignored;
+            serial.close(ignored);
+            configurePort();
+            // The adapter usually kept power through the dropout, so the
+            // warm-start probes pass and recovery is two fast commands;
+            // a power-cycled adapter falls back to the full init.
+            if (!tryWarmStart())
+            {
+                runFullInit();
+            }
+            linkUp.store(true);
+            reconnecting.store(false);
+            std::cout << "ELM327 link restored\n";
+            return;
+        }
+        catch (const std::exception &)
+        {
+            // Port not back yet; try again on the next backoff tick.
+        }
+    }
+    reconnecting.store(false);
+}
+
+void ELM327Interface::runFullInit()
+{
     messageReadOBD("ATZ\r", true);
     messageReadOBD("ATE0\r", true);
     messageReadOBD("ATL0\r", true);
     messageReadOBD("ATSP6\r", true);
     messageReadOBD("ATH0\r", true);
     messageReadOBD("ATAL\r", true);
+
+    // Timing management: the default ST of ~200 ms is dead air after every
+    // response while the adapter waits for ECUs that are not going to
+    // answer. Take over from its built-in adaptive algorithm and start
+    // aggressive; adjustStTime learns the minimum safe wait from there.
+    messageReadOBD("ATAT0\r", true);
+    applyStTime();
+
+    std::string adapterId = messageReadOBD("ATI\r", true);
+    if (!adapterId.empty() && adapterId.back() == '>')
+    {
+        adapterId.pop_back();
+    }
+    writeStateCache(adapterId);
+}
+
+bool ELM327Interface::tryWarmStart()
+{
+    std::ifstream cache(STATE_CACHE_PATH);
+    if (!cache)
+    {
+        return false;
+    }
+
+    std::string cachedId, cachedSignature;
+    std::getline(cache, cachedId);
+    std::getline(cache, cachedSignature);
+    if (cachedId.empty() || cachedSignature != INIT_SIGNATURE)
+    {
+        return false;
+    }
+
+    try
+    {
+        // Two fast probes instead of the full reset: the adapter identity
+        // must match the cache, and ATDPN must still report protocol 6 with
+        // echo off (an echoed command means the adapter was power-cycled
+        // back to defaults).
+        std::string id = messageReadOBD("ATI\r", false, '>', std::chrono::milliseconds(300));
+        if (id.find(cachedId) == std::string::npos)
+        {
+            return false;
+        }
+
+        std::string protocol = messageReadOBD("ATDPN\r", false, '>', std::chrono::milliseconds(300));
+        if (protocol.find("ATDPN") != std::string::npos || protocol.find('6') == std::string::npos)
+        {
+            return false;
+        }
+    }
+    catch (const std::runtime_error &)
+    {
+        return false;
+    }
+
+    std::cout << "ELM327 warm start: adapter state matches cache, skipping init\n";
+    return true;
+}
+
+void ELM327Interface::writeStateCache(const std::string &adapterId)
+{
+    if (adapterId.empty())
+    {
+        return;
+    }
+    std::ofstream cache(STATE_CACHE_PATH, std::ofstream::trunc);
+    if (cache)
+    {
+        cache << adapterId << '\n' << INIT_SIGNATURE << '\n';
+    }
+}
+
+void ELM327Interface::applyStTime()
+{
+    messageReadOBD(std::format("ATST{:02X}\r", stTimeUnits), true);
+}
+
+void ELM327Interface::adjustStTime()
+{
+    // An ST bounce stops the pipeline and talks to the adapter
+    // synchronously, which must not overlap the reconnect thread closing
+    // and reopening the port; the re-check under the lock catches a link
+    // drop that landed after the caller's linkUp test.
+    std::lock_guard<std::mutex> lock(pipelineMutex);
+    if (!linkUp.load() || reconnecting.load())
+    {
+        return;
+    }
+
+    int timeouts = pollTimeouts.exchange(0);
+    if (timeouts > 0)
+    {
+        cleanResponses = 0;
+        if (stTimeUnits < ST_MAX_UNITS)
+        {
+            stTimeUnits = std::min(stTimeUnits * 2, ST_MAX_UNITS);
+            if (pipelineRunning.load())
+            {
+                stopPipeline();
+            }
+            applyStTime();
+        }
+        return;
+    }
+    if (++cleanResponses >= CLEAN_STREAK_TO_TIGHTEN && stTimeUnits > ST_MIN_UNITS)
+    {
+        cleanResponses = 0;
+        stTimeUnits = std::max(stTimeUnits - ST_MIN_UNITS, ST_MIN_UNITS);
+        if (pipelineRunning.load())
+        {
+            stopPipeline();
+        }
+        applyStTime();
+    }
+}
+
+void ELM327Interface::setPidSchedule(const std::string &pid, std::chrono::milliseconds interval)
+{
+    for (auto &schedule : pidSchedules)
+    {
+        if (schedule.pid == pid)
+        {
+            schedule.interval = interval;
+            return;
+        }
+    }
+    pidSchedules.push_back(PidSchedule{pid, interval});
+}
+
+std::string ELM327Interface::composePollCommand()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::string command = "01";
+    int pidCount = 0;
+    expectedPayloadChars = 0;
+    for (auto &schedule : pidSchedules)
+    {
+        if (schedule.interval.count() == 0 || (now - schedule.lastPolled) >= schedule.interval)
+        {
+            command += ' ';
+            command += schedule.pid;
+            schedule.lastPolled = now;
+            pidCount++;
+            // Mode echo ("41") + PID echo + data bytes, two hex chars each.
+            // 0C is the only two-byte PID we poll.
+            expectedPayloadChars += 4 + (schedule.pid == "0C" ? 4 : 2);
+        }
+    }
+    // Trailing digit is the expected-response-count hint; it lets the
+    // adapter return as soon as that many messages have arrived.
+    command += ' ';
+    command += static_cast<char>('0' + std::min(pidCount, 9));
+    command += '\r';
+    return command;
 }
 
 ELM327Interface::~ELM327Interface()
 {
+    shuttingDown.store(true);
+    {
+        std::lock_guard<std::mutex> lock(reconnectThreadMutex);
+        if (reconnectThread.joinable())
+        {
+            reconnectThread.join();
+        }
+    }
+    std::lock_guard<std::mutex> lock(pipelineMutex);
+    stopPipeline();
     if (serial.is_open())
     {
         serial.close();
     }
 }
 
+void ELM327Interface::startPipeline(std::string command)
+{
+    pollCommand = std::move(command);
+    pipelineRunning.store(true);
+    io.restart();
+    workGuard.emplace(boost::asio::make_work_guard(io));
+    boost::asio::post(io, [this]() { pipelineWrite(); });
+    ioThread = std::thread([this]() { io.run(); });
+}
+
+void ELM327Interface::stopPipeline()
+{
+    if (!ioThread.joinable())
+    {
+        return;
+    }
+    pipelineRunning.store(false);
+    workGuard.reset();
+    io.stop();
+    ioThread.join();
+}
+
+void ELM327Interface::pipelineWrite()
+{
+    if (!pidSchedules.empty())
+    {
+        pollCommand = composePollCommand();
+    }
+    boost::asio::async_write(serial, boost::asio::buffer(pollCommand),
+                             [this](const boost::system::error_code &ec, std::size_t /*bytes_transferred*/)
+                             {
+                                 if (ec)
+                                 {
+                                     beginReconnect();
+                                     return;
+                                 }
+                                 pollWriteDone = std::chrono::steady_clock::now();
+                                 pipelineRead();
+                             });
+}
+
+std::chrono::milliseconds ELM327Interface::adaptiveTimeout() const
+{
+    if (latencyEwmaMs < 0.0)
+    {
+        return MAX_READ_TIMEOUT;
+    }
+    auto timeout = std::chrono::milliseconds(
+        static_cast<long long>(latencyEwmaMs * TIMEOUT_MULTIPLIER));
+    return std::clamp(timeout, MIN_READ_TIMEOUT, MAX_READ_TIMEOUT);
+}
+
+void ELM327Interface::recordPollLatency()
+{
+    auto elapsed = std::chrono::steady_clock::now() - pollWriteDone;
+    double elapsedMs = std::chrono::duration<double, std::milli>(elapsed).count();
+    latencyEwmaMs = (latencyEwmaMs < 0.0)
+                        ? elapsedMs
+                        : LATENCY_ALPHA * elapsedMs + (1.0 - LATENCY_ALPHA) * latencyEwmaMs;
+
+    // The adapter round-trip is where nearly all per-sample time goes, so
+    // surface it next to the CPU stages; watching adapter_wait fall as ST
+    // tightens is how the timing management is verified on real hardware.
+    if (Instrumentation::instance().enabled())
+    {
+        Instrumentation::instance().record(
+            ProfileStage::AdapterWait,
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+}
+
+namespace
+{
+    // Read completion test for a poll response. The prompt '>' always ends
+    // a read, but a well-formed response is complete at the '\r' that closes
+    // the line once the expected payload hex chars for the requested PIDs
+    // have arrived — no need to wait the extra character time for the
+    // prompt. A prompt left over from a previous early-terminated read is
+    // skipped rather than treated as a terminator.
+    struct ExpectedPayloadCondition
+    {
+        size_t minPayloadChars;
+
+        template <typename Iterator>
+        std::pair<Iterator, bool> operator()(Iterator begin, Iterator end) const
+        {
+            size_t payload = 0;
+            bool leading = true;
+            for (Iterator it = begin; it != end; ++it)
+            {
+                char c = *it;
+                if (leading && (c == '>' || c == '\r' || c == '\n' || c == ' '))
+                {
+                    continue;
+                }
+                leading = false;
+                if (c == '>')
+                {
+                    return {std::next(it), true};
+                }
+                if (c == '\r' && payload >= minPayloadChars)
+                {
+                    return {std::next(it), true};
+                }
+                if (c != ' ' && c != '\n')
+                {
+                    ++payload;
+                }
+            }
+            return {end, false};
+        }
+    };
+}
+
+namespace boost::asio
+{
+    template <>
+    struct is_match_condition<ExpectedPayloadCondition> : std::true_type
+    {
+    };
+}
+
+void ELM327Interface::pipelineRead()
+{
+    pollTimer.expires_after(adaptiveTimeout());
+    pollTimer.async_wait([this](const boost::system::error_code &ec)
+                         {
+        if (!ec)
+        {
+            serial.cancel();
+        } });
+
+    boost::asio::async_read_until(serial, pollBuf, ExpectedPayloadCondition{expectedPayloadChars},
+                                  [this](const boost::system::error_code &ec, std::size_t /*bytes_transferred*/)
+                                  {
+                                      pollTimer.cancel();
+                                      if (ec == boost::asio::error::operation_aborted)
+                                      {
+                                          // Timed out: drop whatever partial data arrived and re-issue.
+                                          pollTimeouts.fetch_add(1, std::memory_order_relaxed);
+                                          pollBuf.consume(pollBuf.size());
+                                          pipelineWrite();
+                                          return;
+                                      }
+                                      if (ec)
+                                      {
+                                          beginReconnect();
+                                          return;
+                                      }
+
+                                      recordPollLatency();
+
+                                      // Copy the raw bytes into a pooled slot; the parser skips the
+                                      // whitespace the adapter interleaves, so the per-line getline
+                                      // cleanup pass is not needed on this path.
+                                      size_t slot;
+                                      {
+                                          std::lock_guard<std::mutex> lock(responseMutex);
+                                          if (!freeSlots.empty())
+                                          {
+                                              slot = freeSlots.back();
+                                              freeSlots.pop_back();
+                                          }
+                                          else
+                                          {
+                                              // No free slot means the consumer is behind; recycle
+                                              // the oldest unread response.
+                                              slot = readySlots.front();
+                                              readySlots.pop_front();
+                                          }
+                                      }
+
+                                      auto &pooled = responsePool[slot];
+                                      const auto bufs = pollBuf.data();
+                                      pooled.len = std::min(pollBuf.size(), pooled.data.size());
+                                      std::copy_n(boost::asio::buffers_begin(bufs),
+                                                  static_cast<std::ptrdiff_t>(pooled.len), pooled.data.begin());
+                                      pollBuf.consume(pollBuf.size());
+                                      // Put the next request on the wire before handing this response
+                                      // to the sampling thread, so parse time overlaps adapter latency.
+                                      pipelineWrite();
+
+                                      {
+                                          std::lock_guard<std::mutex> lock(responseMutex);
+                                          readySlots.push_back(slot);
+                                      }
+                                      responseReady.notify_one();
+                                  });
+}
+
+std::string ELM327Interface::collectResponse(boost::asio::streambuf &buf)
+{
+    std::string response;
+    std::string input;
+    std::istream is(&buf);
+    while (std::getline(is, input))
+    {
+        input.erase(std::remove(input.begin(), input.end(), ' '), input.end());
+        input.erase(std::remove(input.begin(), input.end(), '\r'), input.end());
+        response += input;
+    }
+    return response;
+}
+
 bool ELM327Interface::isConnected() const
 {
     return serial.is_open();
@@ -46,28 +504,29 @@ std::string ELM327Interface::messageReadOBD(const std::string_view cmd,
                                             char terminator,
                                             const std::chrono::milliseconds &timeout)
 {
+    RPMREV_PROFILE_SCOPE(ProfileStage::SerialRead);
     boost::asio::write(serial, boost::asio::buffer(cmd.data(), cmd.size()));
     io.restart();
 
-    boost::asio::streambuf response_buf;
+    // Synchronous commands only run while the pipeline is stopped, so they
+    // can reuse the persistent poll buffer and timer instead of building
+    // fresh ones per call.
     std::string response;
-
-    boost::asio::steady_timer timer(io);
-    timer.expires_after(timeout);
+    pollTimer.expires_after(timeout);
     bool timed_out = false;
 
-    timer.async_wait([&](const boost::system::error_code &ec)
-                     {
+    pollTimer.async_wait([&](const boost::system::error_code &ec)
+                         {
         if (!ec)
         {
             timed_out = true;
             serial.cancel();
         } });
 
-    boost::asio::async_read_until(serial, response_buf, terminator,
+    boost::asio::async_read_until(serial, pollBuf, terminator,
                                   [&](const boost::system::error_code &ec, std::size_t /*bytes_transferred*/)
                                   {
-                                      timer.cancel();
+                                      pollTimer.cancel();
                                   });
 
     io.run();
@@ -77,14 +536,7 @@ std::string ELM327Interface::messageReadOBD(const std::string_view cmd,
         throw std::runtime_error("Serial read timed out");
     }
 
-    std::string input;
-    std::istream is(&response_buf);
-    while (std::getline(is, input))
-    {
-        input.erase(std::remove(input.begin(), input.end(), ' '), input.end());
-        input.erase(std::remove(input.begin(), input.end(), '\r'), input.end());
-        response += input;
-    }
+    response = collectResponse(pollBuf);
 
     if (printResponse)
     {
@@ -96,77 +548,443 @@ std::string ELM327Interface::messageReadOBD(const std::string_view cmd,
 
 Result<std::tuple<int, int, int, int, long long>> ELM327Interface::getEngineData(const SignalHandler &handler, std::string_view cmd = "01 0C 0D 04 11 05 4\r")
 {
-    std::string response = messageReadOBD("01 0C 0D 04 11 05 4\r", true);
+    // A dropped link fails this sample instead of the whole session; the
+    // reconnect thread brings the port back while the caller keeps its
+    // writer and GearBox state warm.
+    if (!linkUp.load())
+    {
+        return std::unexpected("Adapter link down; reconnect in progress");
+    }
+
+    // ST adjustment needs a synchronous AT exchange, so it runs here
+    // between polls where the pipeline can be bounced safely; the restart
+    // below picks it back up.
+    try
+    {
+        adjustStTime();
+    }
+    catch (const std::runtime_error &)
+    {
+        beginReconnect();
+        return std::unexpected("Adapter link down; reconnect in progress");
+    }
 
-    size_t pos = response.find("0C");
-    int rpm = -1, speedMph = -1, load = -1, throttle = -1;
+    if (!pipelineRunning.load())
+    {
+        std::lock_guard<std::mutex> lock(pipelineMutex);
+        if (linkUp.load() && !pipelineRunning.load())
+        {
+            startPipeline(std::string(cmd));
+        }
+    }
 
-    auto hexByte = [](std::string_view sv) -> std::optional<int>
+    std::string_view response;
     {
-        if (sv.size() < 2)
-            return std::nullopt;
-        int value = 0;
-        auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + 2, value, 16);
-        return (ec == std::errc{}) ? std::optional<int>(value) : std::nullopt;
-    };
+        RPMREV_PROFILE_SCOPE(ProfileStage::SerialRead);
+        std::unique_lock<std::mutex> lock(responseMutex);
+        while (readySlots.empty())
+        {
+            if (!handler.isRunning())
+            {
+                return std::unexpected("Polling stopped before a response arrived");
+            }
+            if (!linkUp.load())
+            {
+                return std::unexpected("Adapter link down; reconnect in progress");
+            }
+            responseReady.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        size_t slot = readySlots.front();
+        readySlots.pop_front();
+        // The previous in-flight slot is done being parsed; hand it back.
+        if (inFlightSlot)
+        {
+            freeSlots.push_back(*inFlightSlot);
+        }
+        inFlightSlot = slot;
+        response = std::string_view(responsePool[slot].data.data(), responsePool[slot].len);
+    }
+
+    RPMREV_PROFILE_SCOPE(ProfileStage::Parse);
+    auto parsed = parseEngineData(response);
+    if (!parsed)
+    {
+        return parsed;
+    }
+
+    // Scheduled-out PIDs parse as -1; carry the last observed value forward
+    // so consumers always see a complete sample.
+    auto [rpm, speedMph, load, throttle, timestamp] = *parsed;
+    if (load < 0)
+    {
+        load = lastLoad;
+    }
+    else
+    {
+        lastLoad = load;
+    }
+    if (throttle < 0)
+    {
+        throttle = lastThrottle;
+    }
+    else
+    {
+        lastThrottle = throttle;
+    }
+    return std::make_tuple(rpm, speedMph, load, throttle, timestamp);
+}
 
-    auto findByteAfterPID = [&](std::string_view pid, size_t &start) -> std::optional<int>
+namespace
+{
+    inline int hexVal(char c)
     {
-        start = response.find(pid, start);
-        if (start == std::string::npos || start + 4 > response.size())
-            return std::nullopt;
-        start += 2;
-        return hexByte(response.substr(start, 2));
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        return -1;
+    }
+
+    // Cursor over the raw adapter bytes. The ELM327 interleaves spaces and
+    // line endings between hex bytes; the scanner steps over those in place
+    // so parsing never copies or reformats the response.
+    class ResponseScanner
+    {
+    public:
+        explicit ResponseScanner(std::string_view data) : data(data) {}
+
+        // Advance the cursor just past the next occurrence of a two-character
+        // PID marker. Whitespace may precede the marker but never splits it.
+        bool seek(std::string_view marker)
+        {
+            while (pos + 1 < data.size())
+            {
+                if (data[pos] == marker[0] && data[pos + 1] == marker[1])
+                {
+                    pos += 2;
+                    return true;
+                }
+                ++pos;
+            }
+            return false;
+        }
+
+        // Decode the next two hex digits as one byte. Returns -1 on
+        // truncated or malformed data.
+        int nextByte()
+        {
+            skipWhitespace();
+            if (pos + 1 >= data.size())
+                return -1;
+            int hi = hexVal(data[pos]);
+            int lo = hexVal(data[pos + 1]);
+            if (hi < 0 || lo < 0)
+                return -1;
+            pos += 2;
+            return (hi << 4) | lo;
+        }
+
+    private:
+        void skipWhitespace()
+        {
+            while (pos < data.size() && (data[pos] == ' ' || data[pos] == '\r' || data[pos] == '\n'))
+            {
+                ++pos;
+            }
+        }
+
+        std::string_view data;
+        size_t pos = 0;
     };
+}
+
+void ELM327Interface::configureAuxChannels(const std::string &pidA, const std::string &pidB)
+{
+    auxMode = true;
+    channelPidA = pidA;
+    channelPidB = pidB;
+    // Replace the engine PID schedules: the whole point of the second
+    // adapter is polling PIDs that cannot share the main adapter's budget.
+    pidSchedules.clear();
+    setPidSchedule(pidA, std::chrono::milliseconds(0));
+    setPidSchedule(pidB, std::chrono::milliseconds(0));
+}
+
+Result<std::tuple<int, int, int, int, long long>> ELM327Interface::parseEngineData(std::string_view response)
+{
+    ResponseScanner scan(response);
+
+    int rpm = -1;
+    int speedMph = -1;
+    if (!auxMode)
+    {
+        if (!scan.seek("0C"))
+            return std::unexpected("Parse error: 0C not found");
+        int A = scan.nextByte();
+        int B = scan.nextByte();
+        if (A < 0 || B < 0)
+            return std::unexpected("Parse error: invalid RPM hex bytes");
+        rpm = (A * 256 + B) / 4;
+
+        if (!scan.seek("0D"))
+            return std::unexpected("Parse error: speed (0D) not found");
+        int speedRaw = scan.nextByte();
+        if (speedRaw < 0)
+            return std::unexpected("Parse error: invalid speed hex byte");
+        speedMph = static_cast<int>(speedRaw * 0.621371);
+    }
+
+    // The channel PIDs (load/throttle on the engine adapter, the configured
+    // pair on an aux adapter) may poll at a lower cadence, so a response
+    // without them is normal. Each gets its own scanner copy so a missing
+    // first channel cannot run the cursor past a present second one. Aux
+    // channels carry the raw byte; only the engine's 04/11 have a known
+    // percentage scaling.
+    int load = -1;
+    ResponseScanner loadScan = scan;
+    if (loadScan.seek(channelPidA))
+    {
+        int loadRaw = loadScan.nextByte();
+        if (loadRaw >= 0)
+            load = auxMode ? loadRaw : static_cast<int>((loadRaw * 100.0) / 255.0);
+    }
 
+    int throttle = -1;
+    ResponseScanner throttleScan = scan;
+    if (throttleScan.seek(channelPidB))
+    {
+        int throttleRaw = throttleScan.nextByte();
+        if (throttleRaw >= 0)
+            throttle = auxMode ? throttleRaw : static_cast<int>((throttleRaw * 100.0) / 255.0);
+    }
+
+    if (auxMode && load < 0 && throttle < 0)
+        return std::unexpected("Parse error: no aux channel in response");
+
+    auto now = std::chrono::system_clock::now();
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    return std::make_tuple(rpm, speedMph, load, throttle, timestamp);
+}
+
+ELM327Monitor::ELM327Monitor(const std::string &portName, unsigned int baudRate,
+                             CanSignal rpmSignal, CanSignal speedSignal)
+    : serial(io), rpmSignal(std::move(rpmSignal)), speedSignal(std::move(speedSignal))
+{
     try
     {
-        if (pos == std::string::npos)
-            throw std::runtime_error("0C not found");
+        serial.open(portName);
+        serial.set_option(boost::asio::serial_port_base::baud_rate(baudRate));
+        serial.set_option(boost::asio::serial_port_base::character_size(8));
+        serial.set_option(boost::asio::serial_port_base::parity(boost::asio::serial_port_base::parity::none));
+        serial.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one));
+        serial.set_option(boost::asio::serial_port_base::flow_control(boost::asio::serial_port_base::flow_control::none));
+    }
+    catch (const boost::system::system_error &e)
+    {
+        std::cerr << "Failed to open port: " << e.what() << '\n';
+        throw;
+    }
 
-        pos += 2;
-        if (pos + 4 > response.size())
-            throw std::runtime_error("0C found but not enough space for valid hex bytes");
+    // Same init as the polled engine except headers stay on: the CAN ID is
+    // how broadcast frames get filtered.
+    command("ATZ\r", std::chrono::milliseconds(2000));
+    command("ATE0\r");
+    command("ATL0\r");
+    command("ATSP6\r");
+    command("ATH1\r");
+    command("ATAL\r");
 
-        auto A = hexByte(response.substr(pos, 2));
-        auto B = hexByte(response.substr(pos + 2, 2));
-        if (!A || !B)
-            throw std::runtime_error("Invalid RPM hex bytes");
+    startMonitor();
+}
 
-        rpm = ((*A) * 256 + *B) / 4;
-        pos += 4;
+ELM327Monitor::~ELM327Monitor()
+{
+    if (ioThread.joinable())
+    {
+        workGuard.reset();
+        io.stop();
+        ioThread.join();
+    }
+    if (serial.is_open())
+    {
+        try
+        {
+            // Any character ends ATMA; leave the adapter at the prompt.
+            boost::asio::write(serial, boost::asio::buffer("\r", 1));
+        }
+        catch (const boost::system::system_error &)
+        {
+        }
+        serial.close();
+    }
+}
 
-        auto speedOpt = findByteAfterPID("0D", pos);
-        if (!speedOpt)
-            throw std::runtime_error("Speed (0D) not found");
-        speedMph = static_cast<int>(*speedOpt * 0.621371);
-        pos += 2;
+bool ELM327Monitor::isConnected() const
+{
+    return serial.is_open();
+}
 
-        auto loadOpt = findByteAfterPID("04", pos);
-        if (!loadOpt)
-            throw std::runtime_error("Load (04) not found");
-        load = static_cast<int>((*loadOpt * 100.0) / 255.0);
-        pos += 2;
+std::string ELM327Monitor::command(std::string_view cmd, const std::chrono::milliseconds &timeout)
+{
+    boost::asio::write(serial, boost::asio::buffer(cmd.data(), cmd.size()));
+    io.restart();
 
-        auto throttleOpt = findByteAfterPID("11", pos);
-        if (!throttleOpt)
-            throw std::runtime_error("Throttle (11) not found");
-        throttle = static_cast<int>((*throttleOpt * 100.0) / 255.0);
+    boost::asio::streambuf responseBuf;
+    boost::asio::steady_timer timer(io);
+    timer.expires_after(timeout);
+    bool timedOut = false;
 
-        auto now = std::chrono::system_clock::now();
-        auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-        return std::make_tuple(rpm, speedMph, load, throttle, timestamp);
+    timer.async_wait([&](const boost::system::error_code &ec)
+                     {
+        if (!ec)
+        {
+            timedOut = true;
+            serial.cancel();
+        } });
+
+    boost::asio::async_read_until(serial, responseBuf, '>',
+                                  [&](const boost::system::error_code & /*ec*/, std::size_t /*bytes_transferred*/)
+                                  {
+                                      timer.cancel();
+                                  });
+
+    io.run();
+
+    if (timedOut)
+    {
+        throw std::runtime_error("Serial read timed out");
+    }
+
+    const auto bufs = responseBuf.data();
+    return std::string(boost::asio::buffers_begin(bufs),
+                       boost::asio::buffers_begin(bufs) + static_cast<std::ptrdiff_t>(responseBuf.size()));
+}
+
+void ELM327Monitor::startMonitor()
+{
+    boost::asio::write(serial, boost::asio::buffer("ATMA\r", 5));
+    monitoring.store(true);
+    io.restart();
+    workGuard.emplace(boost::asio::make_work_guard(io));
+    boost::asio::post(io, [this]() { armRead(); });
+    ioThread = std::thread([this]() { io.run(); });
+}
+
+void ELM327Monitor::armRead()
+{
+    boost::asio::async_read_until(serial, monitorBuf, '\r',
+                                  [this](const boost::system::error_code &ec, std::size_t /*bytes_transferred*/)
+                                  {
+                                      if (ec)
+                                      {
+                                          monitoring.store(false);
+                                          return;
+                                      }
+                                      std::istream is(&monitorBuf);
+                                      std::string line;
+                                      std::getline(is, line, '\r');
+                                      handleMonitorLine(line);
+                                      armRead();
+                                  });
+}
+
+void ELM327Monitor::handleMonitorLine(const std::string &line)
+{
+    // Monitor lines look like "201 8 1A F8 00 00 45 00 00 00": the CAN ID,
+    // then the data bytes. Adapters that print a single-digit length token
+    // fall out of the two-hex-chars filter below on their own.
+    std::stringstream ss(line);
+    std::string token;
+    if (!(ss >> token))
+    {
+        return;
+    }
+
+    bool wantsRpm = (token == rpmSignal.canId);
+    bool wantsSpeed = (token == speedSignal.canId);
+    if (!wantsRpm && !wantsSpeed)
+    {
+        return;
     }
-    catch (const std::runtime_error &e)
+
+    std::vector<int> bytes;
+    while (ss >> token)
     {
-        return std::unexpected(std::format("Parse error: {}", e.what()));
+        if (token.size() != 2)
+        {
+            continue;
+        }
+        int hi = hexVal(token[0]);
+        int lo = hexVal(token[1]);
+        if (hi < 0 || lo < 0)
+        {
+            continue;
+        }
+        bytes.push_back((hi << 4) | lo);
     }
+
+    auto decode = [&bytes](const CanSignal &signal) -> int
+    {
+        if (signal.byteOffset + signal.byteCount > bytes.size())
+        {
+            return -1;
+        }
+        long raw = 0;
+        for (size_t i = 0; i < signal.byteCount; ++i)
+        {
+            raw = (raw << 8) | bytes[signal.byteOffset + i];
+        }
+        return static_cast<int>(raw * signal.scale);
+    };
+
+    std::lock_guard<std::mutex> lock(sampleMutex);
+    if (wantsSpeed)
+    {
+        int speed = decode(speedSignal);
+        if (speed >= 0)
+        {
+            lastSpeed = speed;
+        }
+    }
+    if (wantsRpm)
+    {
+        int rpm = decode(rpmSignal);
+        if (rpm >= 0)
+        {
+            lastRpm = rpm;
+            // RPM frames pace the sample stream; each one publishes a
+            // sample with the latest speed.
+            sampleFresh = true;
+            sampleReady.notify_one();
+        }
+    }
+}
+
+Result<std::tuple<int, int, int, int, long long>> ELM327Monitor::getEngineData(const SignalHandler &handler, std::string_view /*cmd*/)
+{
+    std::unique_lock<std::mutex> lock(sampleMutex);
+    while (!sampleFresh)
+    {
+        if (!handler.isRunning() || !monitoring.load())
+        {
+            return std::unexpected("Monitor stopped before a frame arrived");
+        }
+        sampleReady.wait_for(lock, std::chrono::milliseconds(100));
+    }
+    sampleFresh = false;
+
+    auto now = std::chrono::system_clock::now();
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    return std::make_tuple(lastRpm, lastSpeed, -1, -1, timestamp);
 }
 
-DummyELM327::DummyELM327(bool useTestData)
+DummyELM327::DummyELM327(bool useTestData, std::filesystem::path replayPath)
     : gen(std::chrono::steady_clock::now().time_since_epoch().count() & 0xFFFFFFFF),
       rpmDist(800, 7000),
       speedDist(0, 80),
+      replayPath(std::move(replayPath)),
       dataIndex(0),
       useTestData(useTestData)
 {
@@ -177,6 +995,15 @@ DummyELM327::DummyELM327(bool useTestData)
     std::cout << "DummyELM327 initialized " << (useTestData ? "with test data" : "with random data") << "\n";
 }
 
+DummyELM327::~DummyELM327()
+{
+    stopLoader.store(true);
+    if (loaderThread.joinable())
+    {
+        loaderThread.join();
+    }
+}
+
 bool DummyELM327::isConnected() const
 {
     return true;
@@ -184,14 +1011,37 @@ bool DummyELM327::isConnected() const
 
 Result<std::tuple<int, int, int, int, long long>> DummyELM327::getEngineData(const SignalHandler &handler, std::string_view cmd = "01 0C 0D 04 11 05 4\r")
 {
-    if (useTestData && !testData.empty())
+    if (useTestData && binaryReplay)
     {
-        auto data = testData[dataIndex++];
-        if (dataIndex >= testData.size())
+        const auto &rec = binaryReplay->record(dataIndex++);
+        if (dataIndex >= binaryReplay->recordCount())
         {
             handler.stop();
         }
-        return std::make_tuple(std::get<0>(data), std::get<1>(data), -1, -1, std::get<2>(data));
+        return std::make_tuple(rec.rpm, static_cast<int>(rec.speed), rec.load, rec.throttle, rec.timestamp);
+    }
+    else if (useTestData && loaderThread.joinable())
+    {
+        ReplaySample sample;
+        while (!replayRing.pop(sample))
+        {
+            if (loaderDone.load())
+            {
+                // The loader can push its final rows and set loaderDone
+                // between the failed pop above and this check, so the ring
+                // gets one more look before the tail is declared drained.
+                if (replayRing.pop(sample))
+                {
+                    break;
+                }
+                handler.stop();
+                return std::unexpected("Replay exhausted");
+            }
+            // The loader should stay well ahead; a miss here means it is
+            // still filling the read-ahead buffer.
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return std::make_tuple(sample.rpm, sample.mph, -1, -1, sample.timestamp);
     }
     else
     {
@@ -207,16 +1057,43 @@ Result<std::tuple<int, int, int, int, long long>> DummyELM327::getEngineData(con
 
 void DummyELM327::loadTestData()
 {
-    std::ifstream configFile("logs/2025-08-18_16-13-04.csv");
-    if (!configFile)
+    if (replayPath.extension() == ".rrl")
     {
-        std::cerr << "Warning: Could not open test_data.csv, using random data\n";
+        // Binary sessions replay straight out of the mapping; no parse pass.
+        auto reader = std::make_unique<BinaryLogReader>(replayPath);
+        if (reader->isOpen() && reader->recordCount() > 0)
+        {
+            binaryReplay = std::move(reader);
+            return;
+        }
+        std::cerr << "Warning: Could not replay binary log, using random data\n";
         useTestData = false;
         return;
     }
 
+    if (!std::filesystem::exists(replayPath))
+    {
+        std::cerr << "Warning: Could not open " << replayPath.generic_string() << ", using random data\n";
+        useTestData = false;
+        return;
+    }
+
+    // Parse on a background thread and hand samples over through the
+    // read-ahead ring; startup no longer waits on a whole-file parse.
+    loaderThread = std::thread([this]() { streamReplayFile(); });
+}
+
+void DummyELM327::streamReplayFile()
+{
+    std::ifstream replayFile(replayPath);
+    if (!replayFile)
+    {
+        loaderDone.store(true);
+        return;
+    }
+
     std::string line;
-    while (std::getline(configFile, line))
+    while (!stopLoader.load() && std::getline(replayFile, line))
     {
         if (line.empty() || line[0] == '#')
             continue;
@@ -225,7 +1102,7 @@ void DummyELM327::loadTestData()
         std::string token;
         std::vector<int> intValues;
         long long timestamp = 0;
-        intValues.reserve(6); 
+        intValues.reserve(6);
 
         int tokenIndex = 0;
         while (std::getline(ss, token, ','))
@@ -250,13 +1127,19 @@ void DummyELM327::loadTestData()
 
         if (intValues.size() == 6 && tokenIndex == 7)
         {
-            testData.emplace_back(intValues[0], intValues[1], timestamp);
+            ReplaySample sample{intValues[0], intValues[1], timestamp};
+            while (!replayRing.push(sample))
+            {
+                if (stopLoader.load())
+                {
+                    loaderDone.store(true);
+                    return;
+                }
+                // Consumer is behind the read-ahead; give it a moment.
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
         }
     }
 
-    if (testData.empty())
-    {
-        std::cerr << "Warning: No valid test data found, using random data\n";
-        useTestData = false;
-    }
+    loaderDone.store(true);
 }
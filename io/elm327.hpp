@@ -9,6 +9,11 @@
 #include <iostream>
 #include "../utils/error_handling.hpp"
 #include "../utils/signal_handler.hpp"
+#include "binary_log.hpp"
+#include "../utils/spsc_ring.hpp"
+#include <filesystem>
+#include <memory>
+#include <atomic>
 #include <boost/asio.hpp>
 #include <string>
 #include <string_view>
@@ -21,6 +26,11 @@
 #include <format>
 #include <chrono>
 #include <ctime>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <array>
 
 class ELM327Base
 {
@@ -32,12 +42,149 @@ public:
     virtual bool isConnected() const = 0;
 };
 
+// One mode-01 PID with its polling cadence. interval zero means the PID is
+// requested on every cycle; slower PIDs ride along only when due, keeping
+// the composed command (and therefore the response) as short as possible.
+struct PidSchedule
+{
+    std::string pid;
+    std::chrono::milliseconds interval{0};
+    std::chrono::steady_clock::time_point lastPolled{};
+};
+
 class ELM327Interface : public ELM327Base
 {
 private:
     boost::asio::io_context io;
     boost::asio::serial_port serial;
 
+    // PID scheduler state. RPM and speed poll at full rate; load, throttle
+    // and coolant change slowly and only need to ride along about once a
+    // second. Shorter requests mean shorter responses on the 38400-baud
+    // link, which directly raises the RPM/speed sample rate.
+    std::vector<PidSchedule> pidSchedules;
+    int lastLoad = -1;
+    int lastThrottle = -1;
+
+    std::string composePollCommand();
+
+    // Warm-start cache: the adapter settings survive while the adapter stays
+    // powered, so startup can probe with two fast commands and skip the
+    // ~2 s ATZ reset sequence when the cached state still matches. The
+    // signature covers the full init sequence, including timing management,
+    // so caches written before ATAT0/ATST existed force a full init.
+    static constexpr const char* STATE_CACHE_PATH = "elm327_state.cache";
+    static constexpr const char* INIT_SIGNATURE = "E0L0SP6H0ALAT0ST";
+
+    bool tryWarmStart();
+    void runFullInit();
+    void writeStateCache(const std::string& adapterId);
+
+    // Pipelined polling engine. A dedicated io thread keeps the next request
+    // on the wire while the sampling thread is still parsing the previous
+    // response, so the serial link never sits idle between samples.
+    std::thread ioThread;
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> workGuard;
+    boost::asio::steady_timer pollTimer;
+    boost::asio::streambuf pollBuf;
+    std::string pollCommand;
+    std::mutex responseMutex;
+    std::condition_variable responseReady;
+    // Written by the io thread (beginReconnect) and the sampling thread
+    // (start/stopPipeline), so it has to be atomic like linkUp.
+    std::atomic<bool> pipelineRunning{false};
+    static constexpr size_t MAX_PENDING_RESPONSES = 4;
+
+    // Adaptive read timeout. A fixed 1000 ms deadline turns every adapter
+    // hiccup into a second-long hole in the derivative window; instead the
+    // pipeline tracks an EWMA of observed response latency and times out at
+    // a small multiple of it, bounded so a cold EWMA can neither hang the
+    // loop nor cancel a healthy read.
+    static constexpr double LATENCY_ALPHA = 0.2;
+    static constexpr int TIMEOUT_MULTIPLIER = 4;
+    static constexpr std::chrono::milliseconds MIN_READ_TIMEOUT{30};
+    static constexpr std::chrono::milliseconds MAX_READ_TIMEOUT{1000};
+    double latencyEwmaMs = -1.0;
+    std::chrono::steady_clock::time_point pollWriteDone;
+    size_t expectedPayloadChars = 0;
+
+    std::chrono::milliseconds adaptiveTimeout() const;
+    void recordPollLatency();
+
+    // Adapter timing (ATST/ATAT). ATAT0 switches the adapter's own adaptive
+    // algorithm off so the ST value is authoritative; the interface then
+    // learns the minimum safe wait itself, widening when reads time out and
+    // tightening back after a long clean streak. ST counts in 4 ms units.
+    static constexpr int ST_MIN_UNITS = 5;            // 20 ms floor
+    static constexpr int ST_MAX_UNITS = 50;           // adapter default ~200 ms
+    static constexpr int CLEAN_STREAK_TO_TIGHTEN = 200;
+    int stTimeUnits = 25;
+    int cleanResponses = 0;
+    std::atomic<int> pollTimeouts{0};
+
+    void applyStTime();
+    void adjustStTime();
+
+    // Connection supervision. A radio dropout fails the current Result<>
+    // instead of throwing through main, and a background thread reopens
+    // the port and replays the cached init while the session (writer,
+    // GearBox state) stays alive. getEngineData resumes the pipeline the
+    // moment the link is back.
+    std::string portName;
+    unsigned int baudRate;
+    std::atomic<bool> linkUp{true};
+    std::atomic<bool> reconnecting{false};
+    std::atomic<bool> shuttingDown{false};
+    // reconnectThread is joined/reassigned by beginReconnect (io thread)
+    // and joined by the destructor (main thread); every touch goes through
+    // this mutex so the std::thread object has one owner at a time.
+    std::mutex reconnectThreadMutex;
+    std::thread reconnectThread;
+    static constexpr std::chrono::milliseconds RECONNECT_BACKOFF{500};
+
+    // Serializes pipeline stop/start and synchronous serial use between the
+    // sampling thread (adjustStTime, startPipeline) and the reconnect
+    // thread's port reinit, which otherwise race when a link drop lands
+    // between getEngineData's linkUp check and the ST bounce. beginReconnect
+    // never takes it, so io-thread handlers cannot deadlock against a
+    // holder joining the io thread.
+    std::mutex pipelineMutex;
+
+    void configurePort();
+    void beginReconnect();
+    void reconnectLoop();
+
+    // Preallocated response pool. The io thread copies each response into a
+    // free slot and queues its index; the consumer parses a string_view over
+    // the slot and only releases it when it takes the next one, so the read
+    // path allocates nothing after construction.
+    struct PooledResponse
+    {
+        std::array<char, 512> data;
+        size_t len = 0;
+    };
+    static constexpr size_t RESPONSE_POOL_SIZE = MAX_PENDING_RESPONSES + 2;
+    std::array<PooledResponse, RESPONSE_POOL_SIZE> responsePool;
+    std::vector<size_t> freeSlots;
+    std::deque<size_t> readySlots;
+    std::optional<size_t> inFlightSlot;
+
+    void startPipeline(std::string command);
+    void stopPipeline();
+    void pipelineWrite();
+    void pipelineRead();
+    std::string collectResponse(boost::asio::streambuf& buf);
+
+    // Aux-channel mode: a second adapter polls the PIDs that cannot share
+    // the main adapter's budget (trans temp, brake pressure, ...). Its two
+    // channels replace the engine PID schedules, land in the load/throttle
+    // slots of the engine-data tuple as raw bytes, and RPM/speed stay -1.
+    bool auxMode = false;
+    std::string channelPidA = "04";
+    std::string channelPidB = "11";
+
+    Result<std::tuple<int, int, int, int, long long>> parseEngineData(std::string_view response);
+
 public:
     ELM327Interface(const std::string& portName, unsigned int baudRate);
     ~ELM327Interface();
@@ -48,23 +195,98 @@ public:
                                const bool printResponse = false,
                                char terminator = '>',
                                const std::chrono::milliseconds& timeout = std::chrono::milliseconds(1000));
+
+    void setPidSchedule(const std::string& pid, std::chrono::milliseconds interval);
+    void configureAuxChannels(const std::string& pidA, const std::string& pidB);
+};
+
+// Passive acquisition engine. Instead of polling mode 01 PIDs, the adapter
+// is put in ATMA monitor mode and RPM/speed are decoded straight off the
+// frames the vehicle already broadcasts on the CAN bus. No request
+// round-trip means 50-100 Hz effective sample rates on a typical bus.
+class ELM327Monitor : public ELM327Base
+{
+public:
+    // One broadcast signal: which CAN ID carries it and where it sits in
+    // the frame payload. The defaults match our vehicle; other cars need
+    // their own IDs from a DBC or a capture session.
+    struct CanSignal
+    {
+        std::string canId;
+        size_t byteOffset;
+        size_t byteCount;
+        double scale;
+    };
+
+private:
+    boost::asio::io_context io;
+    boost::asio::serial_port serial;
+    std::thread ioThread;
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> workGuard;
+    boost::asio::streambuf monitorBuf;
+
+    CanSignal rpmSignal;
+    CanSignal speedSignal;
+
+    std::mutex sampleMutex;
+    std::condition_variable sampleReady;
+    int lastRpm = -1;
+    int lastSpeed = -1;
+    bool sampleFresh = false;
+    // Written by the io thread in armRead's error path and read by the
+    // sampling thread's wait loop, so atomic like the polled interface's
+    // linkUp/pipelineRunning flags.
+    std::atomic<bool> monitoring{false};
+
+    std::string command(std::string_view cmd,
+                        const std::chrono::milliseconds& timeout = std::chrono::milliseconds(1000));
+    void startMonitor();
+    void armRead();
+    void handleMonitorLine(const std::string& line);
+
+public:
+    ELM327Monitor(const std::string& portName, unsigned int baudRate,
+                  CanSignal rpmSignal = {"201", 0, 2, 0.25},
+                  CanSignal speedSignal = {"201", 4, 1, 0.621371});
+    ~ELM327Monitor();
+    bool isConnected() const override;
+    Result<std::tuple<int, int, int, int, long long>> getEngineData(const SignalHandler& handler, std::string_view cmd) override;
 };
 
 class DummyELM327 : public ELM327Base
 {
 private:
+    struct ReplaySample
+    {
+        int rpm;
+        int mph;
+        long long timestamp;
+    };
+
     std::mt19937 gen;
     std::uniform_int_distribution<> rpmDist;
     std::uniform_int_distribution<> speedDist;
-    std::vector<std::tuple<int, int, long long>> testData;
+    std::unique_ptr<BinaryLogReader> binaryReplay;
+    std::filesystem::path replayPath;
     size_t dataIndex;
     bool useTestData;
 
+    // Streaming CSV replay: a loader thread parses the log in the background
+    // and keeps this read-ahead ring topped up, so getEngineData never waits
+    // on file parsing and long sessions are never held in memory whole.
+    SpscRing<ReplaySample, 1024> replayRing;
+    std::thread loaderThread;
+    std::atomic<bool> loaderDone{false};
+    std::atomic<bool> stopLoader{false};
+
 public:
-    explicit DummyELM327(bool useTestData = true);
+    explicit DummyELM327(bool useTestData = true,
+                         std::filesystem::path replayPath = "logs/2025-08-18_16-13-04.csv");
+    ~DummyELM327() override;
     bool isConnected() const override;
     Result<std::tuple<int, int, int, int, long long>> getEngineData(const SignalHandler& handler,std::string_view cmd) override;
 
 private:
     void loadTestData();
+    void streamReplayFile();
 };
@@ -0,0 +1,198 @@
+#include "session_index.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+    ChunkIndexRecord emptyChunk(uint32_t firstRow)
+    {
+        ChunkIndexRecord chunk{};
+        chunk.firstRow = firstRow;
+        chunk.minRpm = chunk.minMph = chunk.minGear = chunk.minRevMatch =
+            chunk.minLoad = chunk.minThrottle = std::numeric_limits<int32_t>::max();
+        chunk.maxRpm = chunk.maxMph = chunk.maxGear = chunk.maxRevMatch =
+            chunk.maxLoad = chunk.maxThrottle = std::numeric_limits<int32_t>::min();
+        chunk.firstTimestamp = std::numeric_limits<int64_t>::max();
+        chunk.lastTimestamp = std::numeric_limits<int64_t>::min();
+        return chunk;
+    }
+}
+
+SessionIndexBuilder::SessionIndexBuilder(std::filesystem::path sessionPath,
+                                         std::filesystem::path indexPath)
+    : sessionPath(std::move(sessionPath)),
+      indexPath(std::move(indexPath)),
+      current(emptyChunk(0))
+{
+}
+
+void SessionIndexBuilder::addRow(int rpm, double speed, int gear, int revMatch,
+                                 int load, int throttle, int64_t timestamp)
+{
+    int mph = static_cast<int>(speed);
+    current.minRpm = std::min(current.minRpm, rpm);
+    current.maxRpm = std::max(current.maxRpm, rpm);
+    current.minMph = std::min(current.minMph, mph);
+    current.maxMph = std::max(current.maxMph, mph);
+    current.minGear = std::min(current.minGear, gear);
+    current.maxGear = std::max(current.maxGear, gear);
+    current.minRevMatch = std::min(current.minRevMatch, revMatch);
+    current.maxRevMatch = std::max(current.maxRevMatch, revMatch);
+    current.minLoad = std::min(current.minLoad, load);
+    current.maxLoad = std::max(current.maxLoad, load);
+    current.minThrottle = std::min(current.minThrottle, throttle);
+    current.maxThrottle = std::max(current.maxThrottle, throttle);
+    current.firstTimestamp = std::min(current.firstTimestamp, timestamp);
+    current.lastTimestamp = std::max(current.lastTimestamp, timestamp);
+
+    if (totalRows == 0)
+    {
+        firstTimestamp = timestamp;
+    }
+    lastTimestamp = timestamp;
+    totalRows++;
+
+    if (++rowsInChunk == SESSION_INDEX_CHUNK_ROWS)
+    {
+        closeChunk();
+    }
+}
+
+void SessionIndexBuilder::closeChunk()
+{
+    if (rowsInChunk == 0)
+    {
+        return;
+    }
+    current.rowCount = rowsInChunk;
+    chunks.push_back(current);
+    current = emptyChunk(totalRows);
+    rowsInChunk = 0;
+}
+
+void SessionIndexBuilder::finalize()
+{
+    if (finalized || totalRows == 0)
+    {
+        return;
+    }
+    finalized = true;
+    closeChunk();
+
+    std::string pathStr = sessionPath.generic_string();
+
+    // The writers truncate their output file on open, so a reused session
+    // path (bench runs, an explicit --output) would leave stale records
+    // whose chunk ranges describe rows that no longer exist. When the path
+    // is already indexed, the file is rewritten without those records
+    // before this session lands at the end; otherwise it is a plain
+    // append. Concurrent sessions do not happen (one process per drive),
+    // so no locking is needed.
+    SessionIndexReader existing(indexPath);
+    bool replacing = false;
+    for (const auto& session : existing.sessions())
+    {
+        if (session.path == pathStr)
+        {
+            replacing = true;
+            break;
+        }
+    }
+
+    // An index that exists but failed validation (corrupt or truncated
+    // header) must also be rewritten: appending after the garbage would
+    // leave every future session unreadable.
+    bool rewrite = replacing ||
+                   (!existing.isOpen() && std::filesystem::exists(indexPath));
+    bool fresh = rewrite || !std::filesystem::exists(indexPath);
+    std::ofstream index(indexPath, std::ios::binary |
+                                       (rewrite ? std::ios::trunc : std::ios::app));
+    if (!index)
+    {
+        std::cerr << "Warning: could not append session index: "
+                  << indexPath.generic_string() << '\n';
+        return;
+    }
+    if (fresh)
+    {
+        SessionIndexFileHeader header{};
+        std::memcpy(header.magic, SESSION_INDEX_MAGIC, sizeof(header.magic));
+        header.version = SESSION_INDEX_VERSION;
+        index.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    if (replacing)
+    {
+        for (const auto& session : existing.sessions())
+        {
+            if (session.path == pathStr)
+            {
+                continue;
+            }
+            SessionIndexRecord kept{};
+            std::strncpy(kept.path, session.path.c_str(), SESSION_INDEX_PATH_MAX - 1);
+            kept.rowCount = session.rowCount;
+            kept.chunkCount = static_cast<uint32_t>(session.chunks.size());
+            kept.firstTimestamp = session.firstTimestamp;
+            kept.lastTimestamp = session.lastTimestamp;
+            index.write(reinterpret_cast<const char*>(&kept), sizeof(kept));
+            index.write(reinterpret_cast<const char*>(session.chunks.data()),
+                        static_cast<std::streamsize>(session.chunks.size() * sizeof(ChunkIndexRecord)));
+        }
+    }
+
+    SessionIndexRecord record{};
+    std::strncpy(record.path, pathStr.c_str(), SESSION_INDEX_PATH_MAX - 1);
+    record.rowCount = totalRows;
+    record.chunkCount = static_cast<uint32_t>(chunks.size());
+    record.firstTimestamp = firstTimestamp;
+    record.lastTimestamp = lastTimestamp;
+    index.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    index.write(reinterpret_cast<const char*>(chunks.data()),
+                static_cast<std::streamsize>(chunks.size() * sizeof(ChunkIndexRecord)));
+}
+
+SessionIndexBuilder::~SessionIndexBuilder()
+{
+    finalize();
+}
+
+SessionIndexReader::SessionIndexReader(const std::filesystem::path& indexPath)
+{
+    std::ifstream index(indexPath, std::ios::binary);
+    if (!index)
+    {
+        return;
+    }
+
+    SessionIndexFileHeader header{};
+    index.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!index || std::memcmp(header.magic, SESSION_INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SESSION_INDEX_VERSION)
+    {
+        std::cerr << "Warning: " << indexPath.generic_string() << " is not a valid session index\n";
+        return;
+    }
+
+    SessionIndexRecord record{};
+    while (index.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+        Session session;
+        session.path.assign(record.path,
+                            strnlen(record.path, SESSION_INDEX_PATH_MAX));
+        session.rowCount = record.rowCount;
+        session.firstTimestamp = record.firstTimestamp;
+        session.lastTimestamp = record.lastTimestamp;
+        session.chunks.resize(record.chunkCount);
+        if (!index.read(reinterpret_cast<char*>(session.chunks.data()),
+                        static_cast<std::streamsize>(record.chunkCount * sizeof(ChunkIndexRecord))))
+        {
+            // Truncated tail (e.g. crash mid-append); keep what parsed.
+            break;
+        }
+        sessionList.push_back(std::move(session));
+    }
+    opened = true;
+}
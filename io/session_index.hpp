@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Columnar session index over the logs directory. As each session closes,
+// the writer appends a per-session summary plus a chunk index — min/max of
+// every field over fixed-size row ranges — to one index file (append-only,
+// except that re-recording an already-indexed path replaces its records).
+// A query can then discard whole chunks from the index alone ("no row in
+// this chunk ever exceeded 4000 RPM") and scan only the matching ranges,
+// which turns months-of-logs queries from full-file scans into sub-second
+// lookups. Fixed POD layouts, same convention as the binary log format.
+
+inline constexpr char SESSION_INDEX_MAGIC[] = "RRSI";
+inline constexpr uint32_t SESSION_INDEX_VERSION = 1;
+inline constexpr uint32_t SESSION_INDEX_CHUNK_ROWS = 256;
+inline constexpr size_t SESSION_INDEX_PATH_MAX = 128;
+inline constexpr const char* SESSION_INDEX_DEFAULT_PATH = "logs/session_index.rri";
+
+struct SessionIndexFileHeader
+{
+    char magic[4];
+    uint32_t version;
+};
+static_assert(sizeof(SessionIndexFileHeader) == 8);
+
+// One per session; followed in the file by chunkCount ChunkIndexRecords.
+struct SessionIndexRecord
+{
+    char path[SESSION_INDEX_PATH_MAX];
+    uint32_t rowCount;
+    uint32_t chunkCount;
+    int64_t firstTimestamp;
+    int64_t lastTimestamp;
+};
+static_assert(sizeof(SessionIndexRecord) == 152);
+
+struct ChunkIndexRecord
+{
+    uint32_t firstRow;
+    uint32_t rowCount;
+    int32_t minRpm, maxRpm;
+    int32_t minMph, maxMph;
+    int32_t minGear, maxGear;
+    int32_t minRevMatch, maxRevMatch;
+    int32_t minLoad, maxLoad;
+    int32_t minThrottle, maxThrottle;
+    int64_t firstTimestamp, lastTimestamp;
+};
+static_assert(sizeof(ChunkIndexRecord) == 72);
+
+// Accumulates chunk statistics as the writer emits rows and appends the
+// session's summary and chunk index when the session closes (the writer
+// destructor calls finalize). Losing an index entry on a crash is fine —
+// the session can be re-indexed — so this never fsyncs.
+class SessionIndexBuilder
+{
+private:
+    std::filesystem::path sessionPath;
+    std::filesystem::path indexPath;
+    std::vector<ChunkIndexRecord> chunks;
+    ChunkIndexRecord current{};
+    uint32_t rowsInChunk = 0;
+    uint32_t totalRows = 0;
+    int64_t firstTimestamp = 0;
+    int64_t lastTimestamp = 0;
+    bool finalized = false;
+
+    void closeChunk();
+
+public:
+    explicit SessionIndexBuilder(std::filesystem::path sessionPath,
+                                 std::filesystem::path indexPath = SESSION_INDEX_DEFAULT_PATH);
+
+    void addRow(int rpm, double speed, int gear, int revMatch,
+                int load, int throttle, int64_t timestamp);
+
+    void finalize();
+
+    ~SessionIndexBuilder();
+};
+
+// Read-side of the index: loads every session summary and its chunks so a
+// query tool can prune chunks before touching any session file.
+class SessionIndexReader
+{
+public:
+    struct Session
+    {
+        std::string path;
+        uint32_t rowCount;
+        int64_t firstTimestamp;
+        int64_t lastTimestamp;
+        std::vector<ChunkIndexRecord> chunks;
+    };
+
+    explicit SessionIndexReader(const std::filesystem::path& indexPath = SESSION_INDEX_DEFAULT_PATH);
+
+    bool isOpen() const { return opened; }
+    const std::vector<Session>& sessions() const { return sessionList; }
+
+private:
+    std::vector<Session> sessionList;
+    bool opened = false;
+};
@@ -0,0 +1,151 @@
+#include "shm_export.hpp"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr size_t SHM_TOTAL_SIZE =
+        sizeof(ShmTelemetryHeader) + SHM_TELEMETRY_CAPACITY * sizeof(ShmTelemetryRecord);
+}
+
+ShmTelemetryWriter::ShmTelemetryWriter(std::unique_ptr<BufferedCSVWriterBase> sink)
+    : sink(std::move(sink))
+{
+#ifdef _WIN32
+    mappingHandle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                       0, static_cast<DWORD>(SHM_TOTAL_SIZE),
+                                       ("Local\\" + std::string(SHM_TELEMETRY_NAME)).c_str());
+    if (!mappingHandle)
+    {
+        throw std::runtime_error("Failed to create telemetry shared memory");
+    }
+    mapping = static_cast<char*>(MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, SHM_TOTAL_SIZE));
+    if (!mapping)
+    {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+        throw std::runtime_error("Failed to map telemetry shared memory");
+    }
+#else
+    fd = shm_open(("/" + std::string(SHM_TELEMETRY_NAME)).c_str(),
+                  O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to create telemetry shared memory");
+    }
+    if (ftruncate(fd, static_cast<off_t>(SHM_TOTAL_SIZE)) != 0)
+    {
+        ::close(fd);
+        fd = -1;
+        throw std::runtime_error("Failed to size telemetry shared memory");
+    }
+    void* base = mmap(nullptr, SHM_TOTAL_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+    {
+        ::close(fd);
+        fd = -1;
+        throw std::runtime_error("Failed to map telemetry shared memory");
+    }
+    mapping = static_cast<char*>(base);
+#endif
+
+    std::memset(mapping, 0, SHM_TOTAL_SIZE);
+    header = reinterpret_cast<ShmTelemetryHeader*>(mapping);
+    std::memcpy(header->magic, "RRTM", sizeof(header->magic));
+    header->version = SHM_TELEMETRY_VERSION;
+    header->capacity = SHM_TELEMETRY_CAPACITY;
+    header->recordSize = sizeof(ShmTelemetryRecord);
+    records = reinterpret_cast<ShmTelemetryRecord*>(mapping + sizeof(ShmTelemetryHeader));
+
+    std::cout << "Telemetry shared memory ring \"" << SHM_TELEMETRY_NAME << "\" online ("
+              << SHM_TELEMETRY_CAPACITY << " slots)\n";
+}
+
+void ShmTelemetryWriter::publish(int rpm, double speed, int gear, int revMatch,
+                                 int load, int throttle, int64_t timestamp)
+{
+    uint64_t head = header->head.load(std::memory_order_relaxed);
+    ShmTelemetryRecord& rec = records[head % SHM_TELEMETRY_CAPACITY];
+
+    uint32_t seq = rec.seq.load(std::memory_order_relaxed);
+    rec.seq.store(seq + 1, std::memory_order_relaxed); // odd: update in progress
+    std::atomic_thread_fence(std::memory_order_release);
+
+    rec.rpm = rpm;
+    rec.speed = static_cast<float>(speed);
+    rec.gear = gear;
+    rec.revMatch = revMatch;
+    rec.load = load;
+    rec.throttle = throttle;
+    rec.timestamp = timestamp;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    rec.seq.store(seq + 2, std::memory_order_release); // even: slot consistent
+    header->head.store(head + 1, std::memory_order_release);
+}
+
+void ShmTelemetryWriter::writeRow(int rpm, double speed, int gear, int revMatch,
+                                  int load, int throttle, int64_t timestamp)
+{
+    publish(rpm, speed, gear, revMatch, load, throttle, timestamp);
+    if (sink)
+    {
+        sink->writeRow(rpm, speed, gear, revMatch, load, throttle, timestamp);
+    }
+}
+
+void ShmTelemetryWriter::writeRange(const TelemetryRing& ring, size_t first, size_t count)
+{
+    for (size_t seq = first; seq < first + count; ++seq)
+    {
+        publish(ring.rpmAt(seq), ring.mphAt(seq), ring.gearAt(seq), ring.revMatchAt(seq),
+                ring.loadAt(seq), ring.throttleAt(seq), ring.timestampAt(seq));
+    }
+    if (sink)
+    {
+        sink->writeRange(ring, first, count);
+    }
+}
+
+void ShmTelemetryWriter::flush()
+{
+    if (sink)
+    {
+        sink->flush();
+    }
+}
+
+ShmTelemetryWriter::~ShmTelemetryWriter()
+{
+#ifdef _WIN32
+    if (mapping)
+    {
+        UnmapViewOfFile(mapping);
+    }
+    if (mappingHandle)
+    {
+        CloseHandle(mappingHandle);
+    }
+#else
+    if (mapping)
+    {
+        munmap(mapping, SHM_TOTAL_SIZE);
+    }
+    if (fd >= 0)
+    {
+        ::close(fd);
+        // Readers that already mapped the region keep their view; unlinking
+        // just removes the name so the next session starts clean.
+        shm_unlink(("/" + std::string(SHM_TELEMETRY_NAME)).c_str());
+    }
+#endif
+}
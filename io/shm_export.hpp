@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "csv_writer.hpp"
+
+// Shared-memory live telemetry export. A small named ring in shared memory
+// with a seqlock per slot: the sampling loop publishes each annotated
+// record right after revMatcher returns, and dashboard processes map the
+// same region and read lock-free, seeing data sub-millisecond fresh
+// instead of tailing the CSV behind its flush interval. Layout below is
+// the wire format external readers compile against, hence the packing and
+// size asserts.
+
+inline constexpr char SHM_TELEMETRY_NAME[] = "rpmrevmatch_telemetry";
+inline constexpr uint32_t SHM_TELEMETRY_VERSION = 1;
+inline constexpr uint32_t SHM_TELEMETRY_CAPACITY = 256;
+
+struct ShmTelemetryRecord
+{
+    // Seqlock: odd while the writer is mid-update; readers retry when the
+    // value is odd or changed across their copy of the fields.
+    std::atomic<uint32_t> seq{0};
+    int32_t rpm = 0;
+    float speed = 0.0f;
+    int32_t gear = 0;
+    int32_t revMatch = 0;
+    int32_t load = 0;
+    int32_t throttle = 0;
+    int32_t pad = 0;
+    int64_t timestamp = 0;
+};
+static_assert(sizeof(ShmTelemetryRecord) == 40, "shared layout readers depend on");
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+struct ShmTelemetryHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t recordSize;
+    // Total records ever published; head % capacity is the next slot.
+    std::atomic<uint64_t> head;
+};
+static_assert(sizeof(ShmTelemetryHeader) == 24, "shared layout readers depend on");
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+// Decorator sink: publishes every row into the shared ring, then forwards
+// to the wrapped writer so the CSV/binary log path is unchanged. Wrap it
+// outermost so publication happens on the sampling thread, not behind the
+// async writer's queue. A null sink is allowed: the latency-mode scheduler
+// uses a sink-less instance as the pure cue publisher on the hot lane.
+class ShmTelemetryWriter : public BufferedCSVWriterBase
+{
+private:
+#ifdef _WIN32
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+    char* mapping = nullptr;
+    ShmTelemetryHeader* header = nullptr;
+    ShmTelemetryRecord* records = nullptr;
+    std::unique_ptr<BufferedCSVWriterBase> sink;
+
+    void publish(int rpm, double speed, int gear, int revMatch,
+                 int load, int throttle, int64_t timestamp);
+
+public:
+    explicit ShmTelemetryWriter(std::unique_ptr<BufferedCSVWriterBase> sink);
+
+    void writeRow(int rpm, double speed, int gear, int revMatch,
+                  int load, int throttle, int64_t timestamp) override;
+
+    void writeRange(const TelemetryRing& ring, size_t first, size_t count) override;
+
+    void updateAux(int aux1, int aux2) override
+    {
+        if (sink)
+        {
+            sink->updateAux(aux1, aux2);
+        }
+    }
+
+    void flush() override;
+
+    ~ShmTelemetryWriter() override;
+};
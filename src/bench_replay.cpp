@@ -0,0 +1,134 @@
+// Replay benchmark: drives GearBox and the CSV writer from a recorded
+// session log at maximum speed (no real-time pacing like test mode) and
+// reports throughput plus per-sample latency percentiles. This is the
+// baseline every optimization to the processing path is measured against.
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../config/configuration.hpp"
+#include "../io/csv_writer.hpp"
+#include "../utils/telemetry_ring.hpp"
+#include "gearbox.hpp"
+
+namespace
+{
+    struct ReplayRow
+    {
+        int rpm;
+        int mph;
+        int load;
+        int throttle;
+        long long timestamp;
+    };
+
+    std::vector<ReplayRow> loadReplayRows(const std::filesystem::path &logPath)
+    {
+        std::vector<ReplayRow> rows;
+        std::ifstream logFile(logPath);
+        if (!logFile)
+        {
+            std::cerr << "Could not open log: " << logPath.generic_string() << '\n';
+            return rows;
+        }
+
+        std::string line;
+        while (std::getline(logFile, line))
+        {
+            if (line.empty() || line[0] == '#' || line[0] == 'R') // skip header row
+                continue;
+
+            std::stringstream ss(line);
+            std::string token;
+            std::vector<std::string> tokens;
+            while (std::getline(ss, token, ','))
+            {
+                tokens.push_back(token);
+            }
+            if (tokens.size() < 7)
+                continue;
+
+            try
+            {
+                rows.push_back(ReplayRow{std::stoi(tokens[0]),
+                                         static_cast<int>(std::stod(tokens[1])),
+                                         std::stoi(tokens[4]),
+                                         std::stoi(tokens[5]),
+                                         std::stoll(tokens[6])});
+            }
+            catch (const std::exception &)
+            {
+                continue;
+            }
+        }
+        return rows;
+    }
+
+    long long percentile(const std::vector<long long> &sorted, double p)
+    {
+        if (sorted.empty())
+            return 0;
+        size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+        return sorted[idx];
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::filesystem::path logPath = "logs/2025-08-18_16-13-04.csv";
+    std::filesystem::path configPath = "config.txt";
+    if (argc > 1)
+        logPath = argv[1];
+    if (argc > 2)
+        configPath = argv[2];
+
+    auto configResult = Configuration::fromFile(configPath);
+    if (!configResult)
+    {
+        std::cerr << "Configuration error: " << configResult.error() << std::endl;
+        return 1;
+    }
+
+    auto rows = loadReplayRows(logPath);
+    if (rows.empty())
+    {
+        std::cerr << "No replayable rows in " << logPath.generic_string() << '\n';
+        return 1;
+    }
+    std::cout << "Replaying " << rows.size() << " rows from " << logPath.generic_string() << '\n';
+
+    TelemetryRing ring;
+    auto gearBox = createGearBox(ring, configResult->gear);
+    BufferedCSVWriter csvWriter("logs/bench_output.csv");
+
+    std::vector<long long> latenciesNs;
+    latenciesNs.reserve(rows.size());
+
+    auto runStart = std::chrono::steady_clock::now();
+    for (const auto &row : rows)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        size_t seq = ring.push(row.timestamp, row.rpm, row.mph, row.load, row.throttle);
+        auto [gear, revs] = gearBox->revMatcher(seq);
+        ring.annotate(seq, gear, revs);
+        csvWriter.writeRange(ring, seq, 1);
+        auto t1 = std::chrono::steady_clock::now();
+        latenciesNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+    auto runEnd = std::chrono::steady_clock::now();
+
+    double elapsedSec = std::chrono::duration<double>(runEnd - runStart).count();
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+
+    std::cout << "Elapsed:     " << elapsedSec << " s\n";
+    std::cout << "Throughput:  " << static_cast<long long>(rows.size() / elapsedSec) << " rows/s\n";
+    std::cout << "Latency p50: " << percentile(latenciesNs, 0.50) << " ns\n";
+    std::cout << "Latency p99: " << percentile(latenciesNs, 0.99) << " ns\n";
+    std::cout << "Latency max: " << latenciesNs.back() << " ns\n";
+
+    return 0;
+}
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "../config/configuration.hpp"
+#include "../utils/simd_kernels.hpp"
+#include "../utils/telemetry_ring.hpp"
+
+class GearBoxBase
+{
+public:
+    virtual ~GearBoxBase() = default;
+
+    virtual std::tuple<int, int> revMatcher(size_t seq) = 0;
+};
+
+// Gear count is fixed the moment config.txt is parsed, so the hot path is
+// specialized on it: ratios and lookup tables live in std::arrays sized by
+// the template parameter, the ratio comparison chain fully unrolls, and
+// nothing in revMatcher touches the heap. createGearBox below dispatches to
+// the right instantiation at startup.
+template <size_t N>
+class GearBox : public GearBoxBase
+{
+public:
+    explicit GearBox(const TelemetryRing& ring, const Configuration::GearConfig& config, bool debugMode = false)
+        : debugMode(debugMode),
+          finalDrive(config.final_drive.value()),
+          wheelCircumference(config.wheel_circumference.value()),
+          minRPM(config.min_rpm.value()),
+          maxRPM(config.max_rpm.value()),
+          ring(ring)
+    {
+        std::copy_n(config.gear_ratios.begin(), N, gearRatios.begin());
+
+        std::cout << "Final Drive Ratio: " << finalDrive << "\nGear Ratios:\n";
+        for (size_t i = 0; i < N; ++i) {
+            std::cout << "  Gear " << i+1 << ": " << gearRatios[i] << '\n';
+        }
+        std::cout << "RPM Range: " << minRPM << "-" << maxRPM << "\n";
+        std::cout << "Wheel Circumference: " << wheelCircumference << " inches\n";
+
+        if (debugMode) {
+            gearErrorFile.open("logs/gear_error.txt", std::ofstream::app);
+            lastErrorFlush = std::chrono::steady_clock::now();
+        }
+
+        if (config.smoothing) {
+            if (*config.smoothing == "moving_average") {
+                smoothingMode = Smoothing::MovingAverage;
+            } else if (*config.smoothing == "exponential") {
+                smoothingMode = Smoothing::Exponential;
+            }
+        }
+
+        predictive = config.predictive;
+
+        // Everything in the RPM formula except speed is fixed at construction,
+        // and the 0D PID bounds speed to one byte, so fold the per-gear
+        // multiplier and every speed value into an integer lookup table. The
+        // hot path then never divides.
+        for (size_t g = 0; g < N; ++g) {
+            double multiplier = (TIRE_CONVERSION * finalDrive * gearRatios[g]) / wheelCircumference;
+            gearMultipliers[g] = multiplier;
+            for (int mph = 0; mph < MAX_SPEED; ++mph) {
+                rpmForSpeed[g][mph] = static_cast<int>(multiplier * mph);
+            }
+        }
+    }
+
+    std::tuple<int, int> revMatcher(size_t seq) override
+    {
+        int MPH = ring.mphAt(seq);
+        auto [dR, dM] = getDerivatives(seq);
+        int rpm = smoothRPM(seq);
+        bool diverging = (dR * dM <= 0);
+        bool rpmDecrease = (dR < 0);
+
+        if (predictive)
+        {
+            // By the time a sample reaches us it is already one polling
+            // interval old, so the cue computed from it lands ~70-100 ms
+            // late. Extrapolate RPM and speed forward by the measured
+            // interval using the per-ms window slopes, and match against
+            // where the car will be rather than where it was. The
+            // hold-gear tests above still use the raw slopes.
+            double horizon = sampleIntervalMs(seq);
+            rpm = std::max(0, rpm + static_cast<int>(dR * horizon));
+            MPH = std::clamp(MPH + static_cast<int>(dM * horizon), 0, MAX_SPEED - 1);
+        }
+
+        int currentGear = !(diverging || rpmDecrease) ? getCurrentGear(rpm, MPH) : previousGear;
+        previousGear = currentGear;
+
+        if (currentGear < 2)
+        {
+            return {currentGear, -1};
+        }
+        else
+        {
+                if (debugMode && !(diverging || rpmDecrease)){
+                    logGearError(currentGear, rpm, lookupRPM(currentGear - 1, MPH));
+                }
+                int targetRPM = lookupRPM(currentGear - 2, MPH);
+                if (targetRPM < minRPM || targetRPM > maxRPM)
+                {
+                    return {currentGear, -1};
+                }
+                else
+                {
+                return {currentGear, targetRPM};
+            }
+        }
+    }
+
+    ~GearBox() override
+    {
+        flushGearErrors();
+    }
+
+private:
+    // Gear-error telemetry: percentage error between measured RPM and the
+    // table RPM for the detected gear. Lines batch in memory and flush on
+    // the same size/interval rules as BufferedCSVWriter, replacing the old
+    // open/write/close of logs/temp.txt on nearly every stable sample.
+    bool debugMode;
+    std::ofstream gearErrorFile;
+    std::ostringstream gearErrorBuffer;
+    std::chrono::steady_clock::time_point lastErrorFlush;
+    static constexpr size_t ERROR_BUFFER_MAX = 8192;
+    static constexpr std::chrono::milliseconds ERROR_FLUSH_INTERVAL{5000};
+
+    void logGearError(int gear, int rpm, int cRPM)
+    {
+        gearErrorBuffer << gear << "  " << ((static_cast<double>(rpm - cRPM) / rpm)) * 100 << '\n';
+        auto now = std::chrono::steady_clock::now();
+        if (static_cast<size_t>(gearErrorBuffer.tellp()) >= ERROR_BUFFER_MAX ||
+            (now - lastErrorFlush) >= ERROR_FLUSH_INTERVAL) {
+            flushGearErrors();
+        }
+    }
+
+    void flushGearErrors()
+    {
+        if (gearErrorFile.is_open() && gearErrorBuffer.tellp() > 0) {
+            gearErrorFile << gearErrorBuffer.str();
+            gearErrorFile.flush();
+            gearErrorBuffer.str("");
+            gearErrorBuffer.clear();
+            lastErrorFlush = std::chrono::steady_clock::now();
+        }
+    }
+
+    std::array<double, N> gearRatios{};
+    double finalDrive;
+    double wheelCircumference;
+    int minRPM;
+    int maxRPM;
+    double TIRE_CONVERSION = 1056.0;
+    double KMH_TO_MPH = 0.621371;
+    static constexpr int MAX_SPEED = 256; // 0D PID is a single byte
+    std::array<double, N> gearMultipliers{};
+    std::array<std::array<int, MAX_SPEED>, N> rpmForSpeed{};
+    int previousGear = 1;
+
+    // Optional RPM smoothing ahead of gear detection. The raw 0C signal is
+    // noisy; a cheap vectorized average over the window (or a scalar EMA)
+    // steadies detection without shrinking the derivative threshold.
+    enum class Smoothing { None, MovingAverage, Exponential };
+    Smoothing smoothingMode = Smoothing::None;
+    static constexpr double EMA_ALPHA = 0.25;
+    double emaRPM = -1.0;
+
+    // Predictive lookahead: an EWMA of the inter-sample gap (ring
+    // timestamps, ms) is the pipeline latency we extrapolate across.
+    bool predictive = false;
+    static constexpr double INTERVAL_ALPHA = 0.2;
+    double intervalEwmaMs = -1.0;
+    int64_t prevTimestamp = -1;
+
+    double sampleIntervalMs(size_t seq)
+    {
+        int64_t now = ring.timestampAt(seq);
+        if (prevTimestamp >= 0 && now > prevTimestamp)
+        {
+            double gap = static_cast<double>(now - prevTimestamp);
+            intervalEwmaMs = (intervalEwmaMs < 0.0)
+                                 ? gap
+                                 : INTERVAL_ALPHA * gap + (1.0 - INTERVAL_ALPHA) * intervalEwmaMs;
+        }
+        prevTimestamp = now;
+        return (intervalEwmaMs < 0.0) ? 0.0 : intervalEwmaMs;
+    }
+
+    int smoothRPM(size_t seq)
+    {
+        int rpm = ring.rpmAt(seq);
+        switch (smoothingMode) {
+        case Smoothing::MovingAverage: {
+            size_t count = windowEnd - windowStart;
+            if (count < 2) {
+                return rpm;
+            }
+            // The window may wrap the ring, so sum the two contiguous runs.
+            size_t firstSlot = TelemetryRing::slotOf(windowStart);
+            size_t firstRun = std::min(count, TelemetryRing::CAPACITY - firstSlot);
+            long long sum = sumInt32(ring.rpmData() + firstSlot, firstRun);
+            sum += sumInt32(ring.rpmData(), count - firstRun);
+            return static_cast<int>(sum / static_cast<long long>(count));
+        }
+        case Smoothing::Exponential:
+            emaRPM = (emaRPM < 0.0) ? rpm : EMA_ALPHA * rpm + (1.0 - EMA_ALPHA) * emaRPM;
+            return static_cast<int>(emaRPM);
+        default:
+            return rpm;
+        }
+    }
+
+    // Sample history lives in the shared telemetry ring; GearBox only tracks
+    // which sequence range forms the current derivative window.
+    const TelemetryRing& ring;
+    size_t windowStart = 0;
+    size_t windowEnd = 0;
+    static constexpr size_t MAX_POINTS = 100; // Adjust based on your needs
+    static constexpr int threshold = 250;
+
+    int lookupRPM(size_t gearIndex, int mph) const
+    {
+        return rpmForSpeed[gearIndex][static_cast<size_t>(std::clamp(mph, 0, MAX_SPEED - 1))];
+    }
+
+    int getCurrentGear(int rpm, int mph)
+    {
+
+        if (mph == 0) {
+            return 1;
+        }
+        // rpm > rpmForSpeed[g][mph] is the same comparison as
+        // currentRatio > gearRatios[g], just precomputed into integers. With
+        // N a compile-time constant the chain below fully unrolls.
+        size_t m = static_cast<size_t>(std::clamp(mph, 0, MAX_SPEED - 1));
+        if (rpm >= rpmForSpeed[0][m]) {
+            return 1;
+        }
+        if (rpm <= rpmForSpeed[N - 1][m]) {
+            return static_cast<int>(N - 1);
+        }
+
+        size_t left = 0;
+        while (left < N - 1) {
+            if (rpm > rpmForSpeed[left][m]) {
+                return static_cast<int>(left + 1);
+            }
+            left++;
+        }
+        return static_cast<int>(left + 1);
+    }
+
+    // Running sums of the pairwise slopes inside the window. updatePrevious
+    // adjusts them as points enter and leave, so getDerivatives is O(1)
+    // instead of rescanning all MAX_POINTS with modulo indexing per sample.
+    double rpmSlopeSum = 0.0;
+    double mphSlopeSum = 0.0;
+
+    void addSlope(size_t a, size_t b) {
+        int64_t dt = ring.timestampAt(b) - ring.timestampAt(a);
+        if (dt > 0) {
+            rpmSlopeSum += static_cast<double>(ring.rpmAt(b) - ring.rpmAt(a)) / dt;
+            mphSlopeSum += static_cast<double>(ring.mphAt(b) - ring.mphAt(a)) / dt;
+        }
+    }
+
+    void subtractSlope(size_t a, size_t b) {
+        int64_t dt = ring.timestampAt(b) - ring.timestampAt(a);
+        if (dt > 0) {
+            rpmSlopeSum -= static_cast<double>(ring.rpmAt(b) - ring.rpmAt(a)) / dt;
+            mphSlopeSum -= static_cast<double>(ring.mphAt(b) - ring.mphAt(a)) / dt;
+        }
+    }
+
+    std::pair<double, double> getDerivatives(size_t seq) {
+        updatePrevious(seq);
+
+        size_t count = windowEnd - windowStart;
+        if (count < 2) {
+            return {0.0, 0.0};
+        }
+
+        return {rpmSlopeSum / (count - 1), mphSlopeSum / (count - 1)};
+    }
+
+    void updatePrevious(size_t seq) {
+        int64_t now = ring.timestampAt(seq);
+        while (windowEnd > windowStart) {
+            if (ring.timestampAt(windowStart) > now - threshold &&
+                windowEnd - windowStart < MAX_POINTS) {
+                break;
+            }
+            if (windowEnd - windowStart >= 2) {
+                subtractSlope(windowStart, windowStart + 1);
+            }
+            ++windowStart;
+        }
+
+        if (windowEnd > windowStart) {
+            addSlope(windowEnd - 1, seq);
+        } else {
+            windowStart = seq;
+        }
+        windowEnd = seq + 1;
+
+        if (windowEnd - windowStart < 2) {
+            // Re-anchor the running sums whenever the window empties so
+            // floating-point drift cannot accumulate across a session.
+            rpmSlopeSum = 0.0;
+            mphSlopeSum = 0.0;
+        }
+    }
+};
+
+// Startup dispatch from the parsed gear count to the matching
+// instantiation. Real transmissions land in the 4-8 range.
+inline std::unique_ptr<GearBoxBase> createGearBox(const TelemetryRing& ring,
+                                                  const Configuration::GearConfig& config,
+                                                  bool debugMode = false)
+{
+    switch (config.gear_ratios.size())
+    {
+    case 4: return std::make_unique<GearBox<4>>(ring, config, debugMode);
+    case 5: return std::make_unique<GearBox<5>>(ring, config, debugMode);
+    case 6: return std::make_unique<GearBox<6>>(ring, config, debugMode);
+    case 7: return std::make_unique<GearBox<7>>(ring, config, debugMode);
+    case 8: return std::make_unique<GearBox<8>>(ring, config, debugMode);
+    default:
+        throw std::runtime_error("Unsupported gear count: " +
+                                 std::to_string(config.gear_ratios.size()));
+    }
+}
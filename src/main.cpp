@@ -1,4 +1,6 @@
 #include <boost/asio.hpp>
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -21,172 +23,36 @@
 #include <stdexcept>
 #include "../utils/error_handling.hpp"
 #include "../utils/signal_handler.hpp"
+#include "../utils/telemetry_ring.hpp"
+#include "../utils/spsc_ring.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/thread_affinity.hpp"
 #include "../config/configuration.hpp"
 #include "../io/csv_writer.hpp"
+#include "../io/binary_log.hpp"
+#include "../io/shm_export.hpp"
 #include "../io/elm327.hpp"
+#include "../io/acquisition.hpp"
+#include "gearbox.hpp"
 #include <SDKDDKVer.h>
 #include <thread>  
 using boost::asio::serial_port_base;
 namespace asio = boost::asio;
 
-class GearBox
-{
-public:
-    explicit GearBox(const Configuration::GearConfig& config)
-        : gearRatios(config.gear_ratios),
-          finalDrive(config.final_drive.value()),
-          wheelCircumference(config.wheel_circumference.value()),
-          minRPM(config.min_rpm.value()),
-          maxRPM(config.max_rpm.value())
-    {
-        std::cout << "Final Drive Ratio: " << finalDrive << "\nGear Ratios:\n";
-        for (size_t i = 0; i < gearRatios.size(); ++i) {
-            std::cout << "  Gear " << i+1 << ": " << gearRatios[i] << '\n';
-        }
-        std::cout << "RPM Range: " << minRPM << "-" << maxRPM << "\n";
-        std::cout << "Wheel Circumference: " << wheelCircumference << " inches\n";
-    }
-    
-    std::tuple<int, int> revMatcher(int MPH, int rpm, int64_t now)
-    {
-        auto [dR, dM] = getDerivatives(rpm, MPH, now);
-        bool diverging = (dR * dM <= 0);
-        bool rpmDecrease = (dR < 0);
-        
-        int currentGear = !(diverging || rpmDecrease) ? getCurrentGear(rpm, MPH) : previousGear;
-        previousGear = currentGear;
-        
-        if (currentGear < 2)
-        {
-            return {currentGear, -1};
-        }
-        else
-        {
-            // for (auto g : gearRatios)
-            // {
-                //     std::cout << static_cast<int>((TIRE_CONVERSION * MPH * finalDrive * g) / wheelCircumference) << "  ";
-                // }
-                int cRPM = static_cast<int>((TIRE_CONVERSION * MPH * finalDrive * gearRatios[currentGear - 1]) / wheelCircumference);
-                if (!(diverging || rpmDecrease)){
-
-                    myfile.open("logs/temp.txt", std::ofstream::app);
-                    myfile << currentGear << "  " << ((static_cast<double>(rpm-cRPM)/rpm))*100<< '\n';
-                    myfile.close();
-                }
-                int targetRPM = static_cast<int>((TIRE_CONVERSION * MPH * finalDrive * gearRatios[currentGear - 2]) / wheelCircumference);
-                if (targetRPM < minRPM || targetRPM > maxRPM)
-                {
-                    return {currentGear, -1};
-                }
-                else
-                {
-                return {currentGear, targetRPM};
-            }
-        }
-    }
 
-private:
-    std::ofstream myfile;
-    std::vector<double> gearRatios;
-    double finalDrive;
-    double wheelCircumference;
-    int minRPM;
-    int maxRPM;
-    double TIRE_CONVERSION = 1056.0;
-    double KMH_TO_MPH = 0.621371;
-    int previousGear = 1;
-    struct DataPoint {
-        int64_t timestamp;
-        int rpm;
-        int mph;
-        
-        DataPoint(int64_t t, int r, int m) : timestamp(t), rpm(r), mph(m) {}
-    };
-    static constexpr size_t MAX_POINTS = 100; // Adjust based on your needs
-    std::vector<DataPoint> buffer;
-    size_t start = 0;
-    size_t count = 0;
-    static constexpr int threshold = 250;
-
-    int getCurrentGear(int rpm, int mph)
-    {
-        
-        if (mph == 0) {
-            return 1;
-        }
-        double currentRatioValue = ((rpm * wheelCircumference) / (mph * TIRE_CONVERSION)) / finalDrive;
-        if (currentRatioValue >= gearRatios[0]) {
-            return 1;
-        }
-        if (currentRatioValue <= gearRatios.back()) {
-            return static_cast<int>(gearRatios.size() - 1);
-        }
-
-        int left = 0;
-        while (left<gearRatios.size()-1) {
-            if (currentRatioValue > gearRatios[left]) {
-                return left+1;
-            }
-            left++;
-        }
-        return left+1;
-    }
-    std::pair<double, double> getDerivatives(int rpm, int mph, int64_t now) {
-        updatePrevious(now, rpm, mph);
-        
-        if (count < 2) {
-            return {0.0, 0.0};
-        }
-        
-        double rpmSum = 0.0;
-        double mphSum = 0.0;
-        
-        for (size_t i = 1; i < count; ++i) {
-            const auto& p1 = buffer[(start + i - 1) % MAX_POINTS];
-            const auto& p2 = buffer[(start + i) % MAX_POINTS];
-            
-            int64_t dt = p2.timestamp - p1.timestamp;
-            if (dt > 0) {
-                rpmSum += static_cast<double>(p2.rpm - p1.rpm) / dt;
-                mphSum += static_cast<double>(p2.mph - p1.mph) / dt;
-            }
-        }
-        
-        return {rpmSum / (count - 1), mphSum / (count - 1)};
-    }
-
-    void updatePrevious(int64_t now, int rpm, int mph) {
-        while (count > 0) {
-            const auto& oldest = buffer[start];
-            if (oldest.timestamp > now - threshold) {
-                break;
-            }
-            start = (start + 1) % MAX_POINTS;
-            --count;
-        }
-        
-        if (count < MAX_POINTS) {
-            size_t pos = (start + count) % MAX_POINTS;
-            if (pos >= buffer.size()) {
-                buffer.emplace_back(now, rpm, mph);
-            } else {
-                buffer[pos] = DataPoint(now, rpm, mph);
-            }
-            ++count;
-        } else {
-            buffer[start] = DataPoint(now, rpm, mph);
-            start = (start + 1) % MAX_POINTS;
-        }
-    }
-};
 
 
-
-std::unique_ptr<ELM327Base> createELM327Interface(bool testMode, const std::string &port = "COM9", int baudRate = 38400)
+std::unique_ptr<ELM327Base> createELM327Interface(bool testMode, const std::string &port = "COM9", int baudRate = 38400,
+                                                  const std::filesystem::path &replayPath = "logs/2025-08-18_16-13-04.csv",
+                                                  bool monitorMode = false)
 {
     if (testMode)
     {
-        return std::make_unique<DummyELM327>(true);
+        return std::make_unique<DummyELM327>(true, replayPath);
+    }
+    else if (monitorMode)
+    {
+        return std::make_unique<ELM327Monitor>(port, baudRate);
     }
     else
     {
@@ -195,15 +61,38 @@ std::unique_ptr<ELM327Base> createELM327Interface(bool testMode, const std::stri
 }
 
 
-std::unique_ptr<BufferedCSVWriterBase> createBufferedCSVWriter(const std::filesystem::path& filename, bool testMode, bool debugMode) {
+std::unique_ptr<BufferedCSVWriterBase> createBufferedCSVWriter(const std::filesystem::path& filename, bool testMode, bool debugMode, bool binaryLog = false, bool asyncWriter = false, int syncIntervalMs = 0, bool shmExport = false, int deadbandRpm = 0, bool auxColumns = false) {
+    std::unique_ptr<BufferedCSVWriterBase> writer;
     if (testMode)
     {
-        return std::make_unique<DummyCSVWriter>();
+        writer = std::make_unique<DummyCSVWriter>();
+    }
+    else if (binaryLog)
+    {
+        std::filesystem::path binaryPath = filename;
+        binaryPath.replace_extension(".rrl");
+        writer = std::make_unique<BinaryLogWriter>(binaryPath, debugMode, 256, std::chrono::seconds(5),
+                                                   std::chrono::milliseconds(syncIntervalMs), deadbandRpm);
     }
     else
     {
-        return std::make_unique<BufferedCSVWriter>(filename, debugMode);
+        writer = std::make_unique<BufferedCSVWriter>(filename, debugMode, 8192, std::chrono::seconds(5),
+                                                     std::chrono::milliseconds(syncIntervalMs), deadbandRpm, auxColumns);
     }
+
+    // A periodic fsync belongs on the writer thread, not the sampling loop.
+    if (!testMode && (asyncWriter || syncIntervalMs > 0))
+    {
+        writer = std::make_unique<AsyncCSVWriter>(std::move(writer));
+    }
+
+    // Outermost so the shared-memory publish happens on the sampling thread
+    // the moment the row reaches the writer, not behind the async queue.
+    if (shmExport)
+    {
+        writer = std::make_unique<ShmTelemetryWriter>(std::move(writer));
+    }
+    return writer;
 }
 
 
@@ -211,8 +100,12 @@ std::unique_ptr<BufferedCSVWriterBase> createBufferedCSVWriter(const std::filesy
 int main(int argc, char *argv[])
 {
     SignalHandler handler;
+    // Cold-start latency is driver-visible (the process restarts with the
+    // ignition), so each startup phase is timed and reported below.
+    auto startupBegin = std::chrono::steady_clock::now();
     Configuration config = Configuration::fromCommandLine(argc, argv);
     auto fileConfigResult = Configuration::fromFile(config.app.config_path);
+    auto configDone = std::chrono::steady_clock::now();
 
     if (!fileConfigResult) {
         std::cerr << "Configuration error: " << fileConfigResult.error() << std::endl;
@@ -226,40 +119,148 @@ int main(int argc, char *argv[])
         std::cout << "Running in TEST MODE with dummy ELM327\n";
     }
 
+    Instrumentation::instance().setEnabled(finalConfig.app.debug_mode);
+
     try {
-        GearBox gearBox(finalConfig.gear);
-        auto csvWriter = createBufferedCSVWriter(finalConfig.app.output_path, finalConfig.app.test_mode, finalConfig.app.debug_mode);
-        auto elm = createELM327Interface(finalConfig.app.test_mode, finalConfig.app.serial_port, finalConfig.app.baud_rate);
+        TelemetryRing ring;
+        auto gearBox = createGearBox(ring, finalConfig.gear, finalConfig.app.debug_mode);
+        bool dualAdapter = !finalConfig.app.aux_port.empty() && !finalConfig.app.test_mode;
+        auto csvWriter = createBufferedCSVWriter(finalConfig.app.output_path, finalConfig.app.test_mode, finalConfig.app.debug_mode, finalConfig.app.binary_log, finalConfig.app.async_writer, finalConfig.app.sync_interval_ms, finalConfig.app.shm_export && !finalConfig.app.latency_mode, finalConfig.app.deadband_rpm, dualAdapter);
+
+        // In latency mode the shared-memory cue publisher is detached from
+        // the writer stack and lives on the hot lane.
+        std::unique_ptr<BufferedCSVWriterBase> cuePublisher;
+        if (finalConfig.app.latency_mode && finalConfig.app.shm_export) {
+            cuePublisher = std::make_unique<ShmTelemetryWriter>(nullptr);
+        }
+        auto elm = createELM327Interface(finalConfig.app.test_mode, finalConfig.app.serial_port, finalConfig.app.baud_rate, finalConfig.app.replay_path, finalConfig.app.monitor_mode);
 
         if (!elm->isConnected()) {
             std::cerr << "Failed to connect to ELM327 device\n";
             return 1;
         }
 
+        // All adapters feed the acquisition engine; source 0 drives the
+        // GearBox, higher sources carry the extra PID channels that cannot
+        // share the main adapter's polling budget.
+        MultiAdapterAcquisition acquisition(handler);
+        acquisition.addSource(std::move(elm), "01 0C 0D 04 11 05 4\r");
+        if (dualAdapter) {
+            std::istringstream auxPids(finalConfig.app.aux_pids);
+            std::string pidA, pidB;
+            auxPids >> pidA >> pidB;
+            if (pidA.empty() || pidB.empty()) {
+                std::cerr << "--aux-pids needs two PIDs, e.g. \"5C 5E\"\n";
+                return 1;
+            }
+            auto aux = std::make_unique<ELM327Interface>(finalConfig.app.aux_port, finalConfig.app.baud_rate);
+            if (!aux->isConnected()) {
+                std::cerr << "Failed to connect to aux ELM327 device\n";
+                return 1;
+            }
+            aux->configureAuxChannels(pidA, pidB);
+            acquisition.addSource(std::move(aux), std::format("01 {} {} 2\r", pidA, pidB));
+        }
+
+        auto startupEnd = std::chrono::steady_clock::now();
+        auto ms = [](auto from, auto to) {
+            return std::chrono::duration<double, std::milli>(to - from).count();
+        };
+        std::cout << std::format("Startup: config {:.1f} ms, adapter init {:.1f} ms, total {:.1f} ms\n",
+                                 ms(startupBegin, configDone), ms(configDone, startupEnd),
+                                 ms(startupBegin, startupEnd));
+
+        // Latency mode: two explicit lanes. The hot lane (this thread) runs
+        // acquisition -> revMatcher -> cue publication and nothing else;
+        // annotated sequence numbers cross this lock-free ring to the
+        // logging lane, which owns CSV writing, stats emission and debug
+        // formatting. The lane ring must stay strictly smaller than
+        // TelemetryRing::CAPACITY: the telemetry ring overwrites slots older
+        // than its capacity, so a backlog as deep as the telemetry ring would
+        // let the hot lane overwrite a row the logging lane is still reading.
+        // At 256 the oldest queued sequence is always well inside the live
+        // window.
+        SpscRing<size_t, 256> laneRing;
+        std::atomic<bool> laneStop{false};
+        std::thread loggingLane;
+        if (finalConfig.app.latency_mode) {
+            loggingLane = std::thread([&]() {
+                size_t loggedSeq;
+                while (!laneStop.load(std::memory_order_acquire)) {
+                    bool idle = true;
+                    while (laneRing.pop(loggedSeq)) {
+                        csvWriter->writeRange(ring, loggedSeq, 1);
+                        idle = false;
+                    }
+                    Instrumentation::instance().maybeEmit();
+                    if (idle) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+                while (laneRing.pop(loggedSeq)) {
+                    csvWriter->writeRange(ring, loggedSeq, 1);
+                }
+            });
+            if (finalConfig.app.pin_core >= 0 && !pinCurrentThreadToCore(finalConfig.app.pin_core)) {
+                std::cerr << "Could not pin cue lane to core " << finalConfig.app.pin_core << '\n';
+            }
+        }
+
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        acquisition.start();
         int sampleCount = 0;
         auto now = std::chrono::system_clock::now();
         auto oldtimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
         while (handler.isRunning()) {
-            auto result = elm->getEngineData(handler, "01 0C 0D 04 11 05 4\r");
-            if (!result) {
-                if (finalConfig.app.debug_mode) {
-                    std::cerr << "Parse error: " << result.error() << std::endl;
-                }
+            auto sample = acquisition.next();
+            if (!sample) {
+                continue;
+            }
+            if (sample->source != 0) {
+                // Secondary channel: its PID values ride the load/throttle
+                // slots of the engine-data tuple and land in the Aux
+                // columns of the CSV.
+                csvWriter->updateAux(sample->load, sample->throttle);
                 continue;
             }
 
-            auto [rpm, speed, load, throttle, timestamp] = result.value();
+            auto [src, rpm, speed, load, throttle, timestamp] = *sample;
             if (finalConfig.app.test_mode){
                 std::this_thread::sleep_for(std::chrono::milliseconds(timestamp - oldtimestamp)); 
                 oldtimestamp = timestamp;
             }
             if (rpm > 0 && speed >= 0) {
 
-                auto [gear, revs] = gearBox.revMatcher(speed, rpm, timestamp);
-                csvWriter->writeRow(rpm, speed, gear, revs, load, throttle, timestamp);
+                size_t seq = ring.push(timestamp, rpm, speed, load, throttle);
+                int gear, revs;
+                {
+                    RPMREV_PROFILE_SCOPE(ProfileStage::RevMatch);
+                    std::tie(gear, revs) = gearBox->revMatcher(seq);
+                }
+                ring.annotate(seq, gear, revs);
+                if (finalConfig.app.latency_mode) {
+                    // Cue out first, then hand the row to the logging lane.
+                    // A full lane ring means logging fell behind; the row is
+                    // dropped from the log rather than stalling the cue path.
+                    if (cuePublisher) {
+                        cuePublisher->writeRange(ring, seq, 1);
+                    }
+                    laneRing.push(seq);
+                }
+                else {
+                    RPMREV_PROFILE_SCOPE(ProfileStage::WriteRow);
+                    csvWriter->writeRange(ring, seq, 1);
+                }
                 sampleCount++;
             }
+            if (!finalConfig.app.latency_mode) {
+                Instrumentation::instance().maybeEmit();
+            }
+        }
+
+        if (loggingLane.joinable()) {
+            laneStop.store(true, std::memory_order_release);
+            loggingLane.join();
         }
 
         std::cout << "\nTest completed. Generated " << sampleCount << " samples.\n";
@@ -0,0 +1,197 @@
+// Gear-detection quality benchmark: replays a labeled session log (the
+// logs/test_data.csv format, whose CurrentGear column carries the static
+// RPM-band gear recomputed from the shipped config.txt ratios as ground
+// truth) through GearBox::revMatcher and scores the result — detection accuracy,
+// shift-detection latency, flapping — alongside throughput. Wired into
+// CTest so performance work on the detection engine fails loudly instead
+// of silently degrading detection. Exits non-zero when accuracy drops
+// below the pass threshold.
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../config/configuration.hpp"
+#include "../utils/telemetry_ring.hpp"
+#include "gearbox.hpp"
+
+namespace
+{
+    struct LabeledRow
+    {
+        int rpm;
+        int mph;
+        int gear; // ground truth
+        int load;
+        int throttle;
+        long long timestamp;
+    };
+
+    std::vector<LabeledRow> loadLabeledRows(const std::filesystem::path &logPath)
+    {
+        std::vector<LabeledRow> rows;
+        std::ifstream logFile(logPath);
+        if (!logFile)
+        {
+            std::cerr << "Could not open labeled log: " << logPath.generic_string() << '\n';
+            return rows;
+        }
+
+        std::string line;
+        while (std::getline(logFile, line))
+        {
+            if (line.empty() || line[0] == '#' || line[0] == 'R') // skip header row
+                continue;
+
+            std::stringstream ss(line);
+            std::string token;
+            std::vector<std::string> tokens;
+            while (std::getline(ss, token, ','))
+            {
+                tokens.push_back(token);
+            }
+            if (tokens.size() < 7)
+                continue;
+
+            try
+            {
+                rows.push_back(LabeledRow{std::stoi(tokens[0]),
+                                          static_cast<int>(std::stod(tokens[1])),
+                                          std::stoi(tokens[2]),
+                                          std::stoi(tokens[4]),
+                                          std::stoi(tokens[5]),
+                                          std::stoll(tokens[6])});
+            }
+            catch (const std::exception &)
+            {
+                continue;
+            }
+        }
+        return rows;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::filesystem::path logPath = "logs/test_data.csv";
+    std::filesystem::path configPath = "config.txt";
+    // The labeled gear is the static RPM-band gear for each sample; the
+    // engine intentionally holds the previous gear through decel and
+    // diverging-derivative stretches, so it scores ~75% against those
+    // labels by design. 70% leaves margin for noise while still catching
+    // a real detection regression.
+    double passAccuracyPct = 70.0;
+    if (argc > 1)
+        logPath = argv[1];
+    if (argc > 2)
+        configPath = argv[2];
+    if (argc > 3)
+        passAccuracyPct = std::atof(argv[3]);
+
+    auto configResult = Configuration::fromFile(configPath);
+    if (!configResult)
+    {
+        std::cerr << "Configuration error: " << configResult.error() << std::endl;
+        return 1;
+    }
+
+    auto rows = loadLabeledRows(logPath);
+    if (rows.empty())
+    {
+        std::cerr << "No labeled rows in " << logPath.generic_string() << '\n';
+        return 1;
+    }
+    std::cout << "Scoring " << rows.size() << " labeled samples from "
+              << logPath.generic_string() << '\n';
+
+    TelemetryRing ring;
+    auto gearBox = createGearBox(ring, configResult->gear);
+
+    size_t labelled = 0;
+    size_t correct = 0;
+    size_t labeledShifts = 0;
+    size_t detectedShifts = 0;
+    size_t flaps = 0; // predicted gear changes with no labeled shift underneath
+    std::vector<long long> shiftLatenciesMs;
+
+    int prevLabel = -1;
+    int prevDetected = -1;
+    // Pending labeled shift: the timestamp it happened and the gear it moved
+    // to; latency is measured to the first sample where detection agrees.
+    long long pendingShiftTime = -1;
+    int pendingShiftGear = -1;
+
+    auto runStart = std::chrono::steady_clock::now();
+    for (const auto &row : rows)
+    {
+        size_t seq = ring.push(row.timestamp, row.rpm, row.mph, row.load, row.throttle);
+        auto [gear, revs] = gearBox->revMatcher(seq);
+        ring.annotate(seq, gear, revs);
+
+        if (row.gear > 0)
+        {
+            labelled++;
+            if (gear == row.gear)
+            {
+                correct++;
+            }
+
+            if (prevLabel > 0 && row.gear != prevLabel)
+            {
+                labeledShifts++;
+                pendingShiftTime = row.timestamp;
+                pendingShiftGear = row.gear;
+            }
+            prevLabel = row.gear;
+        }
+
+        if (prevDetected > 0 && gear != prevDetected)
+        {
+            if (pendingShiftGear > 0 && gear == pendingShiftGear)
+            {
+                detectedShifts++;
+                shiftLatenciesMs.push_back(row.timestamp - pendingShiftTime);
+                pendingShiftTime = -1;
+                pendingShiftGear = -1;
+            }
+            else
+            {
+                flaps++;
+            }
+        }
+        prevDetected = gear;
+    }
+    auto runEnd = std::chrono::steady_clock::now();
+
+    double elapsedSec = std::chrono::duration<double>(runEnd - runStart).count();
+    double accuracyPct = labelled == 0 ? 0.0 : 100.0 * static_cast<double>(correct) / labelled;
+    long long latencySum = 0;
+    long long latencyMax = 0;
+    for (long long latency : shiftLatenciesMs)
+    {
+        latencySum += latency;
+        latencyMax = std::max(latencyMax, latency);
+    }
+    double latencyMean = shiftLatenciesMs.empty()
+                             ? 0.0
+                             : static_cast<double>(latencySum) / shiftLatenciesMs.size();
+
+    std::cout << "Accuracy:       " << accuracyPct << "% (" << correct << "/" << labelled << ")\n";
+    std::cout << "Shifts:         " << detectedShifts << "/" << labeledShifts << " detected\n";
+    std::cout << "Shift latency:  mean " << latencyMean << " ms, max " << latencyMax << " ms\n";
+    std::cout << "Flapping:       " << flaps << " spurious gear changes\n";
+    std::cout << "Throughput:     " << static_cast<long long>(rows.size() / std::max(elapsedSec, 1e-9))
+              << " rows/s\n";
+
+    if (accuracyPct < passAccuracyPct)
+    {
+        std::cerr << "FAIL: accuracy " << accuracyPct << "% below threshold "
+                  << passAccuracyPct << "%\n";
+        return 1;
+    }
+    std::cout << "PASS (threshold " << passAccuracyPct << "%)\n";
+    return 0;
+}
@@ -0,0 +1,239 @@
+// Multi-session replay: runs the GearBox pipeline over every session log
+// in a directory in parallel, one GearBox per session, and aggregates
+// gear-detection accuracy and rev-match error against the gear/rev-match
+// columns recorded in the logs. Weeks of driving replay in seconds, which
+// is how threshold and the diverging-detection logic get tuned.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../config/configuration.hpp"
+#include "../utils/telemetry_ring.hpp"
+#include "gearbox.hpp"
+
+namespace
+{
+    struct ReplayRow
+    {
+        int rpm;
+        int mph;
+        int gear;
+        int revMatch;
+        int load;
+        int throttle;
+        long long timestamp;
+    };
+
+    struct SessionStats
+    {
+        std::filesystem::path path;
+        size_t samples = 0;
+        size_t labelled = 0;
+        size_t gearCorrect = 0;
+        size_t revMatchPairs = 0;
+        double revMatchAbsErrorSum = 0.0;
+    };
+
+    std::vector<ReplayRow> loadReplayRows(const std::filesystem::path &logPath)
+    {
+        std::vector<ReplayRow> rows;
+        std::ifstream logFile(logPath);
+        if (!logFile)
+        {
+            return rows;
+        }
+
+        std::string line;
+        while (std::getline(logFile, line))
+        {
+            if (line.empty() || line[0] == '#' || line[0] == 'R') // skip header row
+                continue;
+
+            std::stringstream ss(line);
+            std::string token;
+            std::vector<std::string> tokens;
+            while (std::getline(ss, token, ','))
+            {
+                tokens.push_back(token);
+            }
+            if (tokens.size() < 7)
+                continue;
+
+            try
+            {
+                rows.push_back(ReplayRow{std::stoi(tokens[0]),
+                                         static_cast<int>(std::stod(tokens[1])),
+                                         std::stoi(tokens[2]),
+                                         std::stoi(tokens[3]),
+                                         std::stoi(tokens[4]),
+                                         std::stoi(tokens[5]),
+                                         std::stoll(tokens[6])});
+            }
+            catch (const std::exception &)
+            {
+                continue;
+            }
+        }
+        return rows;
+    }
+
+    SessionStats replaySession(const std::filesystem::path &logPath,
+                               const Configuration::GearConfig &gearConfig)
+    {
+        SessionStats stats;
+        stats.path = logPath;
+
+        auto rows = loadReplayRows(logPath);
+        if (rows.empty())
+        {
+            return stats;
+        }
+
+        TelemetryRing ring;
+        auto gearBox = createGearBox(ring, gearConfig);
+
+        for (const auto &row : rows)
+        {
+            size_t seq = ring.push(row.timestamp, row.rpm, row.mph, row.load, row.throttle);
+            auto [gear, revs] = gearBox->revMatcher(seq);
+            ring.annotate(seq, gear, revs);
+
+            stats.samples++;
+            if (row.gear > 0)
+            {
+                stats.labelled++;
+                if (gear == row.gear)
+                {
+                    stats.gearCorrect++;
+                }
+            }
+            if (row.revMatch > 0 && revs > 0)
+            {
+                stats.revMatchPairs++;
+                stats.revMatchAbsErrorSum += std::abs(revs - row.revMatch);
+            }
+        }
+        return stats;
+    }
+
+    double pct(size_t num, size_t den)
+    {
+        return den == 0 ? 0.0 : 100.0 * static_cast<double>(num) / static_cast<double>(den);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::filesystem::path logDir = "logs";
+    std::filesystem::path configPath = "config.txt";
+    if (argc > 1)
+        logDir = argv[1];
+    if (argc > 2)
+        configPath = argv[2];
+
+    auto configResult = Configuration::fromFile(configPath);
+    if (!configResult)
+    {
+        std::cerr << "Configuration error: " << configResult.error() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> sessions;
+    for (const auto &entry : std::filesystem::directory_iterator(logDir))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".csv")
+        {
+            sessions.push_back(entry.path());
+        }
+    }
+    std::sort(sessions.begin(), sessions.end());
+    if (sessions.empty())
+    {
+        std::cerr << "No session logs in " << logDir.generic_string() << '\n';
+        return 1;
+    }
+
+    // Sessions are coarse work units, so a shared claim counter gives the
+    // same load balance as per-thread deques with stealing: an idle worker
+    // simply claims the next unstarted session, and a thread stuck on one
+    // huge log never holds the others back.
+    unsigned threadCount = std::min<unsigned>(std::thread::hardware_concurrency(),
+                                              static_cast<unsigned>(sessions.size()));
+    threadCount = std::max(threadCount, 1u);
+    std::cout << "Replaying " << sessions.size() << " sessions on "
+              << threadCount << " threads\n";
+
+    std::atomic<size_t> nextSession{0};
+    std::vector<SessionStats> results(sessions.size());
+    std::mutex resultsMutex;
+
+    auto runStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threadCount; ++t)
+    {
+        workers.emplace_back([&]() {
+            while (true)
+            {
+                size_t idx = nextSession.fetch_add(1);
+                if (idx >= sessions.size())
+                {
+                    break;
+                }
+                SessionStats stats = replaySession(sessions[idx], configResult->gear);
+                std::lock_guard<std::mutex> lock(resultsMutex);
+                results[idx] = std::move(stats);
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    auto runEnd = std::chrono::steady_clock::now();
+
+    SessionStats total;
+    for (const auto &stats : results)
+    {
+        if (stats.samples == 0)
+        {
+            std::cout << stats.path.filename().generic_string() << ": no replayable rows\n";
+            continue;
+        }
+        double meanErr = stats.revMatchPairs == 0
+                             ? 0.0
+                             : stats.revMatchAbsErrorSum / static_cast<double>(stats.revMatchPairs);
+        std::cout << stats.path.filename().generic_string()
+                  << ": " << stats.samples << " samples, gear accuracy "
+                  << pct(stats.gearCorrect, stats.labelled) << "% ("
+                  << stats.labelled << " labelled), mean |rev-match error| "
+                  << meanErr << " RPM over " << stats.revMatchPairs << " cues\n";
+
+        total.samples += stats.samples;
+        total.labelled += stats.labelled;
+        total.gearCorrect += stats.gearCorrect;
+        total.revMatchPairs += stats.revMatchPairs;
+        total.revMatchAbsErrorSum += stats.revMatchAbsErrorSum;
+    }
+
+    double elapsedSec = std::chrono::duration<double>(runEnd - runStart).count();
+    double totalMeanErr = total.revMatchPairs == 0
+                              ? 0.0
+                              : total.revMatchAbsErrorSum / static_cast<double>(total.revMatchPairs);
+    std::cout << "----\n";
+    std::cout << "Total:       " << total.samples << " samples in " << elapsedSec << " s ("
+              << static_cast<long long>(total.samples / std::max(elapsedSec, 1e-9)) << " rows/s)\n";
+    std::cout << "Gear:        " << pct(total.gearCorrect, total.labelled) << "% of "
+              << total.labelled << " labelled samples\n";
+    std::cout << "Rev-match:   mean |error| " << totalMeanErr << " RPM over "
+              << total.revMatchPairs << " cues\n";
+
+    return 0;
+}
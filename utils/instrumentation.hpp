@@ -0,0 +1,197 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+// Hot-path instrumentation: RAII scopes around each pipeline stage feed
+// per-stage latency histograms (power-of-two nanosecond buckets) that are
+// aggregated lock-free and emitted to stderr every few seconds. A scope
+// costs two clock reads and a few relaxed atomic increments when enabled,
+// a single branch when disabled at runtime, and nothing at all when the
+// build defines RPMREV_NO_PROFILING.
+
+enum class ProfileStage : size_t
+{
+    SerialRead = 0,
+    Parse,
+    RevMatch,
+    WriteRow,
+    AdapterWait,
+    StageCount
+};
+
+inline const char* profileStageName(ProfileStage stage)
+{
+    switch (stage)
+    {
+    case ProfileStage::SerialRead: return "serial_read";
+    case ProfileStage::Parse:      return "parse";
+    case ProfileStage::RevMatch:   return "rev_match";
+    case ProfileStage::WriteRow:   return "write_row";
+    case ProfileStage::AdapterWait: return "adapter_wait";
+    default:                       return "unknown";
+    }
+}
+
+class Instrumentation
+{
+public:
+    static Instrumentation& instance()
+    {
+        static Instrumentation inst;
+        return inst;
+    }
+
+    void setEnabled(bool value) { enabledFlag.store(value, std::memory_order_relaxed); }
+    bool enabled() const { return enabledFlag.load(std::memory_order_relaxed); }
+
+    void record(ProfileStage stage, uint64_t ns)
+    {
+        auto& hist = hists[static_cast<size_t>(stage)];
+        hist.buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        hist.count.fetch_add(1, std::memory_order_relaxed);
+        hist.sum.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t prev = hist.maxNs.load(std::memory_order_relaxed);
+        while (ns > prev && !hist.maxNs.compare_exchange_weak(prev, ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Cheap to call every loop iteration; emits at most once per interval.
+    void maybeEmit()
+    {
+        if (!enabled())
+        {
+            return;
+        }
+        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                       .count();
+        int64_t last = lastEmitMs.load(std::memory_order_relaxed);
+        if (now - last < EMIT_INTERVAL_MS)
+        {
+            return;
+        }
+        if (!lastEmitMs.compare_exchange_strong(last, now))
+        {
+            return;
+        }
+        emit();
+    }
+
+private:
+    static constexpr size_t BUCKETS = 40;
+    static constexpr int64_t EMIT_INTERVAL_MS = 10000;
+
+    struct StageHist
+    {
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> maxNs{0};
+    };
+
+    std::array<StageHist, static_cast<size_t>(ProfileStage::StageCount)> hists{};
+    std::atomic<int64_t> lastEmitMs{0};
+    std::atomic<bool> enabledFlag{false};
+
+    static size_t bucketOf(uint64_t ns)
+    {
+        size_t bucket = 0;
+        while (ns >>= 1)
+        {
+            ++bucket;
+        }
+        return bucket < BUCKETS ? bucket : BUCKETS - 1;
+    }
+
+    // Upper bound of the bucket holding the requested quantile; good to a
+    // factor of two, which is plenty for spotting which stage ate the time.
+    static uint64_t quantileNs(const StageHist& hist, double q)
+    {
+        uint64_t total = hist.count.load(std::memory_order_relaxed);
+        if (total == 0)
+        {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(q * total);
+        uint64_t seen = 0;
+        for (size_t b = 0; b < BUCKETS; ++b)
+        {
+            seen += hist.buckets[b].load(std::memory_order_relaxed);
+            if (seen > target)
+            {
+                return uint64_t(1) << (b + 1);
+            }
+        }
+        return hist.maxNs.load(std::memory_order_relaxed);
+    }
+
+    void emit()
+    {
+        std::cerr << "=== hot-path stats ===\n";
+        for (size_t s = 0; s < hists.size(); ++s)
+        {
+            const auto& hist = hists[s];
+            uint64_t count = hist.count.load(std::memory_order_relaxed);
+            if (count == 0)
+            {
+                continue;
+            }
+            uint64_t mean = hist.sum.load(std::memory_order_relaxed) / count;
+            std::cerr << profileStageName(static_cast<ProfileStage>(s))
+                      << ": n=" << count
+                      << " mean=" << mean << "ns"
+                      << " p50~" << quantileNs(hist, 0.50) << "ns"
+                      << " p99~" << quantileNs(hist, 0.99) << "ns"
+                      << " max=" << hist.maxNs.load(std::memory_order_relaxed) << "ns\n";
+        }
+    }
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileStage stage)
+        : stage(stage), active(Instrumentation::instance().enabled())
+    {
+        if (active)
+        {
+            startNs = nowNs();
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (active)
+        {
+            Instrumentation::instance().record(stage, nowNs() - startNs);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    static uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    ProfileStage stage;
+    bool active;
+    uint64_t startNs = 0;
+};
+
+#define RPMREV_CONCAT_INNER(a, b) a##b
+#define RPMREV_CONCAT(a, b) RPMREV_CONCAT_INNER(a, b)
+
+#ifndef RPMREV_NO_PROFILING
+#define RPMREV_PROFILE_SCOPE(stage) ProfileScope RPMREV_CONCAT(rpmrevProfileScope_, __LINE__)(stage)
+#else
+#define RPMREV_PROFILE_SCOPE(stage) static_cast<void>(0)
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+
+// Compile-time selected SIMD helpers for kernels over the telemetry window:
+// NEON on the in-car ARM board, AVX2/SSE2 on the dev box, and a scalar
+// fallback so the code builds anywhere. The struct-of-arrays ring layout is
+// what makes these loads contiguous.
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RPMREV_HAS_SSE2 1
+#endif
+
+// Sum of a contiguous int32 run. Window values are small (RPM tops out
+// around 14 bits) so the lanes cannot overflow before the widening at the
+// end.
+inline long long sumInt32(const int* data, size_t count)
+{
+    long long sum = 0;
+    size_t i = 0;
+
+#if defined(__ARM_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = vaddq_s32(acc, vld1q_s32(data + i));
+    }
+#if defined(__aarch64__)
+    sum += vaddvq_s32(acc);
+#else
+    sum += vgetq_lane_s32(acc, 0) + vgetq_lane_s32(acc, 1) +
+           vgetq_lane_s32(acc, 2) + vgetq_lane_s32(acc, 3);
+#endif
+#elif defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8)
+    {
+        acc = _mm256_add_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    for (int lane : lanes)
+    {
+        sum += lane;
+    }
+#elif defined(RPMREV_HAS_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4)
+    {
+        acc = _mm_add_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+    for (; i < count; ++i)
+    {
+        sum += data[i];
+    }
+    return sum;
+}
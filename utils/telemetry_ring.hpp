@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity struct-of-arrays sample history. The main loop pushes each
+// sample exactly once; GearBox, the writers and any future consumer read it
+// back by monotonic sequence index instead of keeping private copies. The
+// separate contiguous arrays keep the derivative window scan inside one or
+// two cache lines rather than striding over per-sample records.
+class TelemetryRing
+{
+public:
+    static constexpr size_t CAPACITY = 1024;
+
+    // Appends a sample and returns its sequence index. Indices are monotonic
+    // for the life of the process; slots older than CAPACITY are overwritten.
+    size_t push(int64_t timestamp, int rpm, int mph, int load, int throttle)
+    {
+        size_t seq = head++;
+        size_t slot = seq & MASK;
+        timestamps[slot] = timestamp;
+        rpms[slot] = rpm;
+        mphs[slot] = mph;
+        loads[slot] = load;
+        throttles[slot] = throttle;
+        gears[slot] = -1;
+        revMatches[slot] = -1;
+        return seq;
+    }
+
+    // Fills in the processing results for a sample after revMatcher has run.
+    void annotate(size_t seq, int gear, int revMatch)
+    {
+        gears[seq & MASK] = gear;
+        revMatches[seq & MASK] = revMatch;
+    }
+
+    int64_t timestampAt(size_t seq) const { return timestamps[seq & MASK]; }
+    int rpmAt(size_t seq) const { return rpms[seq & MASK]; }
+    int mphAt(size_t seq) const { return mphs[seq & MASK]; }
+    int loadAt(size_t seq) const { return loads[seq & MASK]; }
+    int throttleAt(size_t seq) const { return throttles[seq & MASK]; }
+    int gearAt(size_t seq) const { return gears[seq & MASK]; }
+    int revMatchAt(size_t seq) const { return revMatches[seq & MASK]; }
+
+    // Total samples pushed so far; the next push returns this value.
+    size_t size() const { return head; }
+
+    // Raw array access for kernels that want to run vectorized over a slot
+    // range; slotOf maps a sequence index to its position in the arrays.
+    static size_t slotOf(size_t seq) { return seq & MASK; }
+    const int* rpmData() const { return rpms.data(); }
+    const int* mphData() const { return mphs.data(); }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of two");
+
+    std::array<int64_t, CAPACITY> timestamps{};
+    std::array<int, CAPACITY> rpms{};
+    std::array<int, CAPACITY> mphs{};
+    std::array<int, CAPACITY> loads{};
+    std::array<int, CAPACITY> throttles{};
+    std::array<int, CAPACITY> gears{};
+    std::array<int, CAPACITY> revMatches{};
+    size_t head = 0;
+};
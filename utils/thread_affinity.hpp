@@ -0,0 +1,29 @@
+#pragma once
+
+// Optional core pinning for the hot cue lane. On the 4-core in-car board,
+// keeping the cue path off the cores the writer and OS churn on turns
+// worst-case cue latency into a tight bound instead of "whatever else was
+// running". Returns false when the platform refuses the mask.
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+inline bool pinCurrentThreadToCore(int core)
+{
+    if (core < 0)
+    {
+        return false;
+    }
+#ifdef _WIN32
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core) != 0;
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}